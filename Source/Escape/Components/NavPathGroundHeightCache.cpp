@@ -0,0 +1,100 @@
+#include "NavPathGroundHeightCache.h"
+
+/**
+ * Looks up a cell, dropping it if it has expired
+ */
+bool FNavPathGroundHeightCache::Find(const FVector& Point, float MaxVerticalDelta, double CurrentTime, float& OutGroundZ)
+{
+    const FIntPoint Key = ToCell(Point);
+    if (const FCell* Cell = Cells.Find(Key))
+    {
+        if (Lifetime > 0.0 && CurrentTime - Cell->Timestamp > Lifetime)
+        {
+            Cells.Remove(Key);
+        }
+        else if (FMath::Abs(Point.Z - Cell->GroundZ) <= MaxVerticalDelta)
+        {
+            OutGroundZ = Cell->GroundZ;
+            ++Hits;
+            return true;
+        }
+    }
+    ++Misses;
+    return false;
+}
+
+/**
+ * Stores the impact height for a cell
+ */
+void FNavPathGroundHeightCache::Store(const FVector& Point, float GroundZ, double CurrentTime)
+{
+    FCell& Cell = Cells.FindOrAdd(ToCell(Point));
+    Cell.GroundZ = GroundZ;
+    Cell.Timestamp = CurrentTime;
+}
+
+/**
+ * Removes the cells overlapping a box
+ */
+void FNavPathGroundHeightCache::InvalidateBox(const FBox& Bounds)
+{
+    if (!Bounds.IsValid || Cells.Num() == 0)
+    {
+        return;
+    }
+
+    const FIntPoint MinCell = ToCell(Bounds.Min);
+    const FIntPoint MaxCell = ToCell(Bounds.Max);
+    const int64 NumBoxCells = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+    // Large dirty areas are cheaper to handle by walking the cache instead of the box
+    if (NumBoxCells > Cells.Num())
+    {
+        for (auto It = Cells.CreateIterator(); It; ++It)
+        {
+            const FIntPoint& Key = It.Key();
+            if (Key.X >= MinCell.X && Key.X <= MaxCell.X && Key.Y >= MinCell.Y && Key.Y <= MaxCell.Y)
+            {
+                It.RemoveCurrent();
+            }
+        }
+        return;
+    }
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            Cells.Remove(FIntPoint(X, Y));
+        }
+    }
+}
+
+/**
+ * Removes every cell
+ */
+void FNavPathGroundHeightCache::Invalidate()
+{
+    Cells.Reset();
+}
+
+/**
+ * Changes the cell size and drops the now mismatched cells
+ */
+void FNavPathGroundHeightCache::SetCellSize(float NewCellSize)
+{
+    NewCellSize = FMath::Max(NewCellSize, 1.0f);
+    if (!FMath::IsNearlyEqual(NewCellSize, CellSize))
+    {
+        CellSize = NewCellSize;
+        Cells.Reset();
+    }
+}
+
+/**
+ * Converts a location into grid cell coordinates
+ */
+FIntPoint FNavPathGroundHeightCache::ToCell(const FVector& Point) const
+{
+    return FIntPoint(FMath::FloorToInt32(Point.X / CellSize), FMath::FloorToInt32(Point.Y / CellSize));
+}
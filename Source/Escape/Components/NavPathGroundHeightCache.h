@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ *  FNavPathGroundHeightCache
+ * Persistent XY grid of ground impact heights used behind NavPathGuide ground projection.
+ * Each cell stores the Z of the last trace that hit ground inside it. Cells expire after a lifetime
+ * and can be invalidated by box when the navmesh or nearby geometry changes.
+ */
+class ESCAPE_API FNavPathGroundHeightCache
+{
+public:
+    /**
+     *  Looks up the ground height of the cell containing Point.
+     *  @param Point The world location to look up
+     *  @param MaxVerticalDelta Cached heights further than this from Point.Z are ignored (other floors)
+     *  @param CurrentTime World time used to expire cells
+     *  @param OutGroundZ Cached impact Z on a hit
+     *  @return True on a cache hit
+     */
+    bool Find(const FVector& Point, float MaxVerticalDelta, double CurrentTime, float& OutGroundZ);
+
+    /**
+     *  Stores the ground impact height for the cell containing Point.
+     *  @param Point The world location that was traced
+     *  @param GroundZ The impact Z of the trace
+     *  @param CurrentTime World time the trace was made
+     */
+    void Store(const FVector& Point, float GroundZ, double CurrentTime);
+
+    /**  Removes every cell overlapping the given box (XY only). */
+    void InvalidateBox(const FBox& Bounds);
+
+    /**  Removes every cell. */
+    void Invalidate();
+
+    /**  Changes the cell size. Existing cells are dropped since their keys no longer match. */
+    void SetCellSize(float NewCellSize);
+
+    /**  Sets how long cells stay valid in seconds (0 = never expire). */
+    void SetLifetime(double NewLifetime) { Lifetime = NewLifetime; }
+
+    /**  Resets hit/miss counters. */
+    void ResetStats() { Hits = 0; Misses = 0; }
+
+    int32 GetHits() const { return Hits; }
+    int32 GetMisses() const { return Misses; }
+    int32 GetNumCells() const { return Cells.Num(); }
+
+private:
+    /** One cached ground height. */
+    struct FCell
+    {
+        float GroundZ = 0.0f;
+        double Timestamp = 0.0;
+    };
+
+    /**  Grid cell containing the given location. */
+    FIntPoint ToCell(const FVector& Point) const;
+
+    TMap<FIntPoint, FCell> Cells;
+    float CellSize = 25.0f;
+    double Lifetime = 30.0;
+    int32 Hits = 0;
+    int32 Misses = 0;
+};
@@ -0,0 +1,160 @@
+#include "NavPathGroundProjector.h"
+
+/**
+ * Submits every point of the batch as an async line trace
+ */
+bool FNavPathGroundProjector::Submit(UWorld* InWorld, const TArray<FVector>& Points, const FNavPathGroundTraceSettings& InSettings, FOnGroundProjectionComplete InOnComplete)
+{
+    Cancel();
+
+    if (!InWorld || Points.Num() == 0)
+    {
+        return false;
+    }
+
+    World = InWorld;
+    Settings = InSettings;
+    OnComplete = MoveTemp(InOnComplete);
+
+    SourcePoints = Points;
+    ProjectedPoints = Points; // Unresolved points fall back to their source location
+    PointStages.Init(ETraceStage::Primary, Points.Num());
+    PointHits.Init(false, Points.Num());
+
+    for (int32 i = 0; i < SourcePoints.Num(); ++i)
+    {
+        if (!SubmitTrace(i))
+        {
+            PointStages[i] = ETraceStage::Done;
+        }
+    }
+
+    // Nothing went out, so no trace result will ever complete the batch
+    if (OutstandingTraces == 0)
+    {
+        CompleteBatch();
+    }
+    return true;
+}
+
+/**
+ * Drops the batch in flight
+ */
+void FNavPathGroundProjector::Cancel()
+{
+    // Bumping the id is enough - late results compare against it and are discarded
+    ++CurrentBatchId;
+    OutstandingTraces = 0;
+    OnComplete.Unbind();
+    SourcePoints.Reset();
+    ProjectedPoints.Reset();
+    PointStages.Reset();
+    PointHits.Reset();
+}
+
+/**
+ * Issues the trace for a point at its current stage
+ */
+bool FNavPathGroundProjector::SubmitTrace(int32 PointIndex)
+{
+    UWorld* TraceWorld = World.Get();
+    if (!TraceWorld)
+    {
+        return false;
+    }
+
+    const FVector& Point = SourcePoints[PointIndex];
+    const float TraceDist = Settings.TraceDistance;
+    FVector Start;
+    FVector End;
+    switch (PointStages[PointIndex])
+    {
+    case ETraceStage::Primary:
+        Start = Point + FVector(0, 0, TraceDist * 0.5f);
+        End = Point - FVector(0, 0, TraceDist * 0.5f);
+        break;
+    case ETraceStage::Wide:
+        // Longer downward trace from higher up if the primary trace fails
+        Start = Point + FVector(0, 0, TraceDist);
+        End = Point - FVector(0, 0, TraceDist * 2.0f);
+        break;
+    case ETraceStage::Deep:
+        // Find the lowest point below (e.g., for holes)
+        Start = Point + FVector(0, 0, 10.0f);
+        End = Point - FVector(0, 0, 100000.0f);
+        break;
+    default:
+        return false;
+    }
+
+    FTraceDelegate TraceDelegate = FTraceDelegate::CreateSP(this, &FNavPathGroundProjector::OnTraceDone, CurrentBatchId);
+    TraceWorld->AsyncLineTraceByChannel(
+        EAsyncTraceType::Single,
+        Start,
+        End,
+        Settings.TraceChannel,
+        Settings.QueryParams,
+        FCollisionResponseParams::DefaultResponseParam,
+        &TraceDelegate,
+        static_cast<uint32>(PointIndex)
+    );
+    ++OutstandingTraces;
+    ++TotalTraceCount;
+    return true;
+}
+
+/**
+ * Resolves the point on a hit, or escalates it to the next trace stage on a miss
+ */
+void FNavPathGroundProjector::OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId)
+{
+    if (BatchId != CurrentBatchId)
+    {
+        return; // Result of a dropped batch
+    }
+
+    const int32 PointIndex = static_cast<int32>(Datum.UserData);
+    if (!PointStages.IsValidIndex(PointIndex))
+    {
+        return;
+    }
+    --OutstandingTraces;
+
+    const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+    if (Hit)
+    {
+        ProjectedPoints[PointIndex] = Hit->ImpactPoint + FVector(0, 0, Settings.OffsetAboveGround);
+        PointStages[PointIndex] = ETraceStage::Done;
+        PointHits[PointIndex] = true;
+    }
+    else
+    {
+        PointStages[PointIndex] = static_cast<ETraceStage>(static_cast<uint8>(PointStages[PointIndex]) + 1);
+        // A point whose escalation cannot be issued keeps its source location
+        if (PointStages[PointIndex] != ETraceStage::Done && !SubmitTrace(PointIndex))
+        {
+            PointStages[PointIndex] = ETraceStage::Done;
+        }
+    }
+
+    if (OutstandingTraces == 0)
+    {
+        CompleteBatch();
+    }
+}
+
+/**
+ * Hands the projected points to the caller
+ */
+void FNavPathGroundProjector::CompleteBatch()
+{
+    // Move state out first - the callback may submit a new batch
+    FOnGroundProjectionComplete Callback = MoveTemp(OnComplete);
+    TArray<FVector> Result = MoveTemp(ProjectedPoints);
+    TBitArray<> HitMask = MoveTemp(PointHits);
+    OnComplete.Unbind();
+    SourcePoints.Reset();
+    PointStages.Reset();
+
+    Callback.ExecuteIfBound(Result, HitMask);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "WorldCollision.h"
+
+/**
+ * Called once every point of a batch has been traced. Points keep the order they were submitted in;
+ * HitMask is false for points where no ground was found and the source location was kept.
+ */
+DECLARE_DELEGATE_TwoParams(FOnGroundProjectionComplete, const TArray<FVector>& /*ProjectedPoints*/, const TBitArray<>& /*HitMask*/);
+
+/**
+ *  Trace settings used for a ground projection batch.
+ *  Mirrors the parameters of UNavPathGuideComponent::ProjectPointToGround.
+ */
+struct FNavPathGroundTraceSettings
+{
+    /** Total length of the primary trace, centred on the point. */
+    float TraceDistance = 10000.0f;
+
+    /** Height added above the impact point. */
+    float OffsetAboveGround = 5.0f;
+
+    /** Channel to trace against. */
+    ECollisionChannel TraceChannel = ECC_Visibility;
+
+    /** Query params shared by every trace in the batch (ignored actors etc.). */
+    FCollisionQueryParams QueryParams;
+};
+
+/**
+ *  FNavPathGroundProjector
+ * Projects a whole polyline onto the ground with the world's async line traces.
+ * Every point is submitted in one batch; points that miss fall back to a wider trace and then a deep trace,
+ * matching the synchronous ProjectPointToGround. The completion delegate fires once all points are resolved.
+ * Only one batch is in flight at a time - submitting a new batch drops the previous one.
+ */
+class ESCAPE_API FNavPathGroundProjector : public TSharedFromThis<FNavPathGroundProjector>
+{
+public:
+    /**
+     *  Submits a batch of points for ground projection, superseding any batch in flight.
+     *  @param World The world to trace in
+     *  @param Points The points to project
+     *  @param Settings Trace distance, offset, channel and query params
+     *  @param OnComplete Called with the projected points once the batch is done
+     *  @return True if the batch was submitted
+     */
+    bool Submit(UWorld* World, const TArray<FVector>& Points, const FNavPathGroundTraceSettings& Settings, FOnGroundProjectionComplete OnComplete);
+
+    /**  Drops the batch in flight. Pending trace results are ignored when they arrive. */
+    void Cancel();
+
+    /**  Whether a batch is waiting for trace results. */
+    bool IsBusy() const { return OutstandingTraces > 0; }
+
+    /**  Number of line traces submitted since the projector was created. */
+    int32 GetTotalTraceCount() const { return TotalTraceCount; }
+
+private:
+    /** Trace stages tried in order until one hits. */
+    enum class ETraceStage : uint8
+    {
+        Primary,
+        Wide,
+        Deep,
+        Done
+    };
+
+    /**  Issues the trace for the given point at its current stage. Returns false if no trace could be issued. */
+    bool SubmitTrace(int32 PointIndex);
+
+    /**  Async trace callback. BatchId identifies the batch the trace belongs to. */
+    void OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId);
+
+    /**  Fires the completion delegate and resets the batch. */
+    void CompleteBatch();
+
+    TWeakObjectPtr<UWorld> World;
+    FNavPathGroundTraceSettings Settings;
+    FOnGroundProjectionComplete OnComplete;
+
+    /** Source points, projected results and the trace stage of each point. */
+    TArray<FVector> SourcePoints;
+    TArray<FVector> ProjectedPoints;
+    TArray<ETraceStage> PointStages;
+    TBitArray<> PointHits;
+
+    /** Incremented per batch so late results of dropped batches can be recognised. */
+    uint32 CurrentBatchId = 0;
+    int32 OutstandingTraces = 0;
+    int32 TotalTraceCount = 0;
+};
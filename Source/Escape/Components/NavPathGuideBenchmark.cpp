@@ -0,0 +1,429 @@
+#include "NavPathGuideComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Tests/AutomationCommon.h"
+#include "Engine/Engine.h"
+#include "NavigationSystem.h"
+#include "UObject/UObjectIterator.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ *  FNavPathGuideBenchmark
+ * Drives a NavPathGuide over scripted routes of increasing length and writes what each route cost to a CSV:
+ * wall time of GeneratePathToLocation (which includes building the visuals) and UpdatePathIfNeeded, ground line
+ * traces, spline points and live spline mesh components. Destinations are laid out on a fixed spiral around the owner,
+ * so runs on the same map are comparable. Passing a previous CSV as Baseline reports every route that got
+ * slower or traced more than the tolerance allows.
+ *
+ * Usage: NavPathGuide.Benchmark [Routes=8] [Spacing=750] [Warm=0] [Baseline=<csv>] [Tolerance=1.25]
+ * The Escape.NavPathGuide.Benchmark automation test opens a map, waits for its navmesh, runs the same routes and
+ * fails on regressions; it takes its baseline from -NavPathGuideBaseline=<csv> and the map from
+ * -NavPathGuideBenchmarkMap=<map> on the command line.
+ */
+struct FNavPathGuideBenchmark
+{
+    /** Cost of one scripted route. */
+    struct FSample
+    {
+        int32 Route = 0;
+        float Distance = 0.0f;
+        bool bPathFound = false;
+        double GenerateMs = 0.0;
+        double UpdateMs = 0.0;
+        int32 GroundTraces = 0;
+        int32 SplinePoints = 0;
+        int32 LiveSplineMeshes = 0;
+    };
+
+    /**
+     *  Runs the routes, writes the CSV and compares it to the baseline if one was given.
+     *  @param OutNumRegressed Number of routes that regressed against the baseline
+     *  @return False if the benchmark could not run
+     */
+    static bool Run(const TArray<FString>& Args, UWorld* World, int32& OutNumRegressed);
+
+    /**  Console command entry point. */
+    static void RunFromConsole(const TArray<FString>& Args, UWorld* World);
+
+private:
+    /**  The guide on the first player's pawn, or the first guide in the world. */
+    static UNavPathGuideComponent* FindGuide(UWorld* World);
+
+    /**  Visible, registered spline mesh components in the guide's pool. */
+    static int32 CountLiveSplineMeshes(const UNavPathGuideComponent* Guide);
+
+    /**  Times one route: a fresh path request, including its visuals, and an update. */
+    static FSample RunRoute(UNavPathGuideComponent* Guide, int32 RouteIndex, const FVector& Destination, float Distance, bool bWarm);
+
+    static FString ToCsv(const TArray<FSample>& Samples);
+
+    /**
+     *  Compares the run against an earlier CSV.
+     *  @return Number of routes that regressed
+     */
+    static int32 CompareToBaseline(const TArray<FSample>& Samples, const FString& BaselineFile, float Tolerance);
+};
+
+/**
+ * Runs the scripted routes and writes the CSV
+ */
+bool FNavPathGuideBenchmark::Run(const TArray<FString>& Args, UWorld* World, int32& OutNumRegressed)
+{
+    OutNumRegressed = 0;
+    const FString Params = FString::Join(Args, TEXT(" "));
+    int32 NumRoutes = 8;
+    float Spacing = 750.0f;
+    bool bWarm = false;
+    float Tolerance = 1.25f;
+    FString BaselineFile;
+    FParse::Value(*Params, TEXT("Routes="), NumRoutes);
+    FParse::Value(*Params, TEXT("Spacing="), Spacing);
+    FParse::Bool(*Params, TEXT("Warm="), bWarm);
+    FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+    FParse::Value(*Params, TEXT("Baseline="), BaselineFile);
+    NumRoutes = FMath::Max(NumRoutes, 1);
+
+    UNavPathGuideComponent* Guide = FindGuide(World);
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+    if (!Guide || !NavSys || !Guide->GetOwner())
+    {
+        UE_LOG(LogTemp, Error, TEXT("[NavPathGuide] Benchmark needs a NavPathGuide component and a navigation system in the world."));
+        return false;
+    }
+
+    // Every stage has to finish inside the timed calls
+    const bool bWasAsyncPathfinding = Guide->bUseAsyncPathfinding;
+    const bool bWasAsyncGroundProjection = Guide->bAsyncGroundProjection;
+    const bool bWasTimeSliced = Guide->bTimeSliceVisualRebuild;
+    const bool bWasShowingGuide = Guide->bShowNavGuide;
+    const FVector PreviousDestination = Guide->PathDestination;
+    Guide->bUseAsyncPathfinding = false;
+    Guide->bAsyncGroundProjection = false;
+    Guide->bTimeSliceVisualRebuild = false;
+    Guide->bShowNavGuide = true;
+    Guide->PathMesh.LoadSynchronous();
+    Guide->ArrowMesh.LoadSynchronous();
+    Guide->PathMaterial.LoadSynchronous();
+
+    // Destinations spiral outwards so each route is longer than the last
+    const FVector Origin = Guide->GetOwner()->GetActorLocation();
+    const FVector QueryExtent(Spacing * 0.5f, Spacing * 0.5f, 1000.0f);
+    TArray<FSample> Samples;
+    for (int32 RouteIndex = 0; RouteIndex < NumRoutes; ++RouteIndex)
+    {
+        const float Distance = Spacing * (RouteIndex + 1);
+        const float Angle = RouteIndex * 2.39996f; // Golden angle spreads the routes over the map
+        const FVector Target = Origin + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Distance;
+
+        FNavLocation Destination;
+        if (!NavSys->ProjectPointToNavigation(Target, Destination, QueryExtent))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("[NavPathGuide] Benchmark route %d: no navmesh near %s, skipped."), RouteIndex, *Target.ToString());
+            continue;
+        }
+        Samples.Add(RunRoute(Guide, RouteIndex, Destination.Location, Distance, bWarm));
+    }
+
+    Guide->bUseAsyncPathfinding = bWasAsyncPathfinding;
+    Guide->bAsyncGroundProjection = bWasAsyncGroundProjection;
+    Guide->bTimeSliceVisualRebuild = bWasTimeSliced;
+    Guide->bShowNavGuide = bWasShowingGuide;
+    Guide->ClearPath();
+    Guide->PathDestination = PreviousDestination;
+
+    const FString CsvFile = FPaths::ProfilingDir() / TEXT("NavPathGuide") / FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString());
+    if (FFileHelper::SaveStringToFile(ToCsv(Samples), *CsvFile))
+    {
+        UE_LOG(LogTemp, Display, TEXT("[NavPathGuide] Benchmark wrote %d routes to %s"), Samples.Num(), *CsvFile);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("[NavPathGuide] Benchmark could not write %s"), *CsvFile);
+    }
+
+    if (!BaselineFile.IsEmpty())
+    {
+        OutNumRegressed = CompareToBaseline(Samples, BaselineFile, Tolerance);
+        if (OutNumRegressed > 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[NavPathGuide] Benchmark: %d route(s) regressed against %s"), OutNumRegressed, *BaselineFile);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Display, TEXT("[NavPathGuide] Benchmark: no regressions against %s"), *BaselineFile);
+        }
+    }
+    return true;
+}
+
+/**
+ * Runs the benchmark from the console; results go to the log
+ */
+void FNavPathGuideBenchmark::RunFromConsole(const TArray<FString>& Args, UWorld* World)
+{
+    int32 NumRegressed = 0;
+    Run(Args, World, NumRegressed);
+}
+
+/**
+ * Finds the guide to benchmark
+ */
+UNavPathGuideComponent* FNavPathGuideBenchmark::FindGuide(UWorld* World)
+{
+    if (APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr)
+    {
+        if (APawn* Pawn = PC->GetPawn())
+        {
+            if (UNavPathGuideComponent* Guide = Pawn->FindComponentByClass<UNavPathGuideComponent>())
+            {
+                return Guide;
+            }
+        }
+    }
+    for (TObjectIterator<UNavPathGuideComponent> It; It; ++It)
+    {
+        if (It->GetWorld() == World && It->IsRegistered())
+        {
+            return *It;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Counts the guide's pooled spline meshes that are currently drawn; other spline meshes in the level are ignored
+ */
+int32 FNavPathGuideBenchmark::CountLiveSplineMeshes(const UNavPathGuideComponent* Guide)
+{
+    int32 Count = 0;
+    for (const USplineMeshComponent* SplineMesh : Guide->SplineMeshes)
+    {
+        if (SplineMesh && SplineMesh->IsRegistered() && SplineMesh->IsVisible())
+        {
+            ++Count;
+        }
+    }
+    return Count;
+}
+
+/**
+ * Times one route from a cold request
+ */
+FNavPathGuideBenchmark::FSample FNavPathGuideBenchmark::RunRoute(UNavPathGuideComponent* Guide, int32 RouteIndex, const FVector& Destination, float Distance, bool bWarm)
+{
+    FSample Sample;
+    Sample.Route = RouteIndex;
+    Sample.Distance = Distance;
+
+    Guide->ClearPath();
+    if (!bWarm)
+    {
+        // Cold runs measure the full pipeline rather than the caches
+        Guide->GroundHeightCache.Invalidate();
+        Guide->RouteCache.Invalidate();
+    }
+    const int32 TracesBefore = Guide->GetGroundTraceCount();
+
+    double StartTime = FPlatformTime::Seconds();
+    Sample.bPathFound = Guide->GeneratePathToLocation(Destination);
+    Sample.GenerateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    StartTime = FPlatformTime::Seconds();
+    Guide->UpdatePathIfNeeded();
+    Sample.UpdateMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    Sample.GroundTraces = Guide->GetGroundTraceCount() - TracesBefore;
+    Sample.SplinePoints = Guide->PathSpline ? Guide->PathSpline->GetNumberOfSplinePoints() : 0;
+    Sample.LiveSplineMeshes = CountLiveSplineMeshes(Guide);
+    return Sample;
+}
+
+/**
+ * Formats the samples, one route per row
+ */
+FString FNavPathGuideBenchmark::ToCsv(const TArray<FSample>& Samples)
+{
+    FString Csv = TEXT("Route,Distance,PathFound,GenerateMs,UpdateMs,GroundTraces,SplinePoints,LiveSplineMeshes\n");
+    for (const FSample& Sample : Samples)
+    {
+        Csv += FString::Printf(TEXT("%d,%.0f,%d,%.3f,%.3f,%d,%d,%d\n"),
+            Sample.Route, Sample.Distance, Sample.bPathFound ? 1 : 0, Sample.GenerateMs, Sample.UpdateMs,
+            Sample.GroundTraces, Sample.SplinePoints, Sample.LiveSplineMeshes);
+    }
+    return Csv;
+}
+
+/**
+ * Flags routes that got slower or traced more than the baseline allows
+ */
+int32 FNavPathGuideBenchmark::CompareToBaseline(const TArray<FSample>& Samples, const FString& BaselineFile, float Tolerance)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *BaselineFile) || Lines.Num() < 2)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[NavPathGuide] Benchmark could not read baseline %s"), *BaselineFile);
+        return 0;
+    }
+
+    // Columns are looked up by name, so baselines written before a column was added or removed still compare
+    TArray<FString> Header;
+    Lines[0].ParseIntoArray(Header, TEXT(","));
+    const int32 RouteColumn = Header.IndexOfByKey(TEXT("Route"));
+    const int32 GenerateColumn = Header.IndexOfByKey(TEXT("GenerateMs"));
+    const int32 UpdateColumn = Header.IndexOfByKey(TEXT("UpdateMs"));
+    const int32 TracesColumn = Header.IndexOfByKey(TEXT("GroundTraces"));
+    if (RouteColumn == INDEX_NONE || GenerateColumn == INDEX_NONE || UpdateColumn == INDEX_NONE || TracesColumn == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Error, TEXT("[NavPathGuide] Benchmark baseline %s is missing columns"), *BaselineFile);
+        return 0;
+    }
+    const int32 NumColumns = FMath::Max(FMath::Max(RouteColumn, GenerateColumn), FMath::Max(UpdateColumn, TracesColumn)) + 1;
+
+    // Sub-0.1ms timings are mostly noise, so they get an absolute allowance on top of the tolerance
+    constexpr double TimeSlackMs = 0.1;
+    int32 NumRegressed = 0;
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        TArray<FString> Fields;
+        Lines[LineIndex].ParseIntoArray(Fields, TEXT(","));
+        if (Fields.Num() < NumColumns)
+        {
+            continue;
+        }
+        const int32 Route = FCString::Atoi(*Fields[RouteColumn]);
+        const FSample* Sample = Samples.FindByPredicate([Route](const FSample& Candidate) { return Candidate.Route == Route; });
+        if (!Sample)
+        {
+            continue;
+        }
+
+        const double BaselineMs = FCString::Atod(*Fields[GenerateColumn]) + FCString::Atod(*Fields[UpdateColumn]);
+        const double SampleMs = Sample->GenerateMs + Sample->UpdateMs;
+        const int32 BaselineTraces = FCString::Atoi(*Fields[TracesColumn]);
+        const bool bSlower = SampleMs > BaselineMs * Tolerance + TimeSlackMs;
+        const bool bMoreTraces = Sample->GroundTraces > FMath::CeilToInt32(BaselineTraces * Tolerance);
+        if (bSlower || bMoreTraces)
+        {
+            UE_LOG(LogTemp, Error, TEXT("[NavPathGuide] Benchmark route %d regressed: %.3f ms (baseline %.3f), %d traces (baseline %d)"),
+                Route, SampleMs, BaselineMs, Sample->GroundTraces, BaselineTraces);
+            ++NumRegressed;
+        }
+    }
+    return NumRegressed;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs NavPathGuideBenchmarkCommand(
+    TEXT("NavPathGuide.Benchmark"),
+    TEXT("Times NavPathGuide over routes of increasing length and writes a CSV to Saved/Profiling/NavPathGuide. ")
+    TEXT("Args: Routes=8 Spacing=750 Warm=0 Baseline=<csv> Tolerance=1.25"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FNavPathGuideBenchmark::RunFromConsole));
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ *  Waits for the opened map's world and navmesh, then runs the benchmark in it.
+ *  Skips with a warning if no game world shows up, e.g. when the map could not be loaded.
+ */
+class FNavPathGuideBenchmarkLatentCommand : public IAutomationLatentCommand
+{
+public:
+    FNavPathGuideBenchmarkLatentCommand(FAutomationTestBase* InTest, const TArray<FString>& InArgs, const FString& InBaselineFile)
+        : Test(InTest)
+        , Args(InArgs)
+        , BaselineFile(InBaselineFile)
+    {
+    }
+
+    virtual bool Update() override
+    {
+        // Navmesh generation can take a while on a freshly loaded map
+        constexpr double TimeoutSeconds = 120.0;
+        const bool bTimedOut = GetCurrentRunTime() > TimeoutSeconds;
+
+        UWorld* World = FindGameWorld();
+        if (!World || !World->HasBegunPlay())
+        {
+            if (bTimedOut)
+            {
+                Test->AddWarning(TEXT("NavPathGuide benchmark skipped: no game world with a navigable map is running."));
+                return true;
+            }
+            return false;
+        }
+        const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+        if (NavSys && NavSys->IsNavigationBuildInProgress() && !bTimedOut)
+        {
+            return false;
+        }
+
+        int32 NumRegressed = 0;
+        if (!FNavPathGuideBenchmark::Run(Args, World, NumRegressed))
+        {
+            Test->AddError(TEXT("NavPathGuide benchmark could not run; see the log."));
+        }
+        else if (NumRegressed > 0)
+        {
+            Test->AddError(FString::Printf(TEXT("%d NavPathGuide benchmark route(s) regressed against %s."), NumRegressed, *BaselineFile));
+        }
+        return true;
+    }
+
+private:
+    /**  The PIE or game world the map was opened in. */
+    static UWorld* FindGameWorld()
+    {
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            if (Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game)
+            {
+                return Context.World();
+            }
+        }
+        return nullptr;
+    }
+
+    FAutomationTestBase* Test;
+    TArray<FString> Args;
+    FString BaselineFile;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FNavPathGuideBenchmarkTest, "Escape.NavPathGuide.Benchmark",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+ * Opens the benchmark map and, once its navmesh is built, fails on regressions against the command line baseline.
+ * The map defaults to ThirdPersonMap and can be changed with -NavPathGuideBenchmarkMap=<map>.
+ */
+bool FNavPathGuideBenchmarkTest::RunTest(const FString& Parameters)
+{
+    FString MapName = TEXT("/Game/Levels/ThirdPersonMap");
+    FParse::Value(FCommandLine::Get(), TEXT("NavPathGuideBenchmarkMap="), MapName);
+    if (!AutomationOpenMap(MapName))
+    {
+        AddWarning(FString::Printf(TEXT("NavPathGuide benchmark skipped: could not open %s."), *MapName));
+        return true;
+    }
+
+    TArray<FString> Args;
+    FString BaselineFile;
+    if (FParse::Value(FCommandLine::Get(), TEXT("NavPathGuideBaseline="), BaselineFile))
+    {
+        Args.Add(FString::Printf(TEXT("Baseline=%s"), *BaselineFile));
+    }
+    ADD_LATENT_AUTOMATION_COMMAND(FNavPathGuideBenchmarkLatentCommand(this, Args, BaselineFile));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+#endif // !UE_BUILD_SHIPPING
@@ -2,6 +2,7 @@
 #include "GameFramework/Actor.h"
 #include "NavigationSystem.h"
 #include "NavMesh/NavMeshPath.h"
+#include "NavMesh/RecastNavMesh.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
@@ -10,39 +11,43 @@
 #include "Materials/MaterialParameterCollection.h"
 #include "Materials/MaterialParameterCollectionInstance.h"
 #include "Kismet/KismetSystemLibrary.h" 
+#include "NavFilters/NavigationQueryFilter.h"
+#include "NavAgentInterface.h"
+#include "NavPathGroundProjector.h"
+#include "NavigationData.h"
+#include "../WellnessBlock.h"
+#include "../Subsystems/WellnessRouteTableSubsystem.h"
+#include "../Subsystems/WellnessBlockRegistrySubsystem.h"
+#include "Algo/Reverse.h"
+#include "Engine/AssetManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("NavPathGuide"), STATGROUP_NavPathGuide, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Generate Path"), STAT_NavPathGuide_GeneratePath, STATGROUP_NavPathGuide);
+DECLARE_CYCLE_STAT(TEXT("Update Path If Needed"), STAT_NavPathGuide_UpdatePathIfNeeded, STATGROUP_NavPathGuide);
+DECLARE_CYCLE_STAT(TEXT("Update Path Visuals"), STAT_NavPathGuide_UpdatePathVisuals, STATGROUP_NavPathGuide);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Traces"), STAT_NavPathGuide_GroundTraces, STATGROUP_NavPathGuide);
+CSV_DEFINE_CATEGORY(NavPathGuide, true);
 /**
  * Constructor for UNavPathGuideComponent
  * Sets default values and configures the component for ticking
  */
 UNavPathGuideComponent::UNavPathGuideComponent()
 {
-    // This component needs to tick to update path visuals for animated path types
-    PrimaryComponentTick.bCanEverTick = true;    
+    // The tick only continues time-sliced visual rebuilds and stays off otherwise;
+    // path updates are driven by movement and navmesh events, and the animated pulse runs in the material
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
     // Initialize properties
     PathDestination = FVector::ZeroVector;
     LastPlayerLocation = FVector::ZeroVector;
     bHasActivePath = false;
     
-    // By default, look for a simple cylindrical mesh for path visualization
-    static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMeshFinder(TEXT("/Engine/BasicShapes/Cylinder"));
-    if (CylinderMeshFinder.Succeeded())
-    {
-        PathMesh = CylinderMeshFinder.Object;
-    }
-    
-    // Also try to find an arrow mesh for detailed path mode
-    static ConstructorHelpers::FObjectFinder<UStaticMesh> ArrowMeshFinder(TEXT("/Engine/BasicShapes/Cone"));
-    if (ArrowMeshFinder.Succeeded())
-    {
-        ArrowMesh = ArrowMeshFinder.Object;
-    }
-    
-    // Look for a material that we know works well with dynamic color changes
-    static ConstructorHelpers::FObjectFinder<UMaterialInterface> DefaultEmissiveMaterial(TEXT("/Engine/BasicShapes/BasicShapeMaterial"));
-    if (DefaultEmissiveMaterial.Succeeded())
-    {
-        PathMaterial = DefaultEmissiveMaterial.Object;
-    }
+    // Default visuals are only referenced here; they load on the first path request (see RequestVisualAssets)
+    PathMesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cylinder.Cylinder")));
+    ArrowMesh = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cone.Cone")));
+    // A material that works well with dynamic color changes
+    PathMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial")));
 }
 
 /**
@@ -61,6 +66,23 @@ void UNavPathGuideComponent::BeginPlay()
     {
         LastPlayerLocation = CachedEscapeCharacter->GetActorLocation();
     }
+    
+    // Ground heights expire when the navmesh or geometry around them changes
+    GroundHeightCache.SetCellSize(GroundCacheCellSize);
+    GroundHeightCache.SetLifetime(GroundCacheLifetime);
+    RouteCache.SetCapacity(RouteCacheCapacity);
+    NavigationDirtiedHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &UNavPathGuideComponent::OnNavigationDirtied);
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UNavPathGuideComponent::OnNavigationGenerationFinished);
+    }
+    
+    // Owner movement wakes automatic updates, so nothing has to poll every frame
+    if (USceneComponent* Root = GetOwner() ? GetOwner()->GetRootComponent() : nullptr)
+    {
+        WatchedRootComponent = Root;
+        OwnerTransformUpdatedHandle = Root->TransformUpdated.AddUObject(this, &UNavPathGuideComponent::OnOwnerTransformUpdated);
+    }
 }
 
 /**
@@ -72,6 +94,41 @@ void UNavPathGuideComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
     // Clear any existing path and cleanup
     ClearPath();
     
+    DestroySplineMeshPool();
+    if (PathRibbon)
+    {
+        PathRibbon->DestroyComponent();
+        PathRibbon = nullptr;
+        RibbonSectionVertexCount = 0;
+    }
+    
+    UNavigationSystemV1::NavigationDirtyEvent.Remove(NavigationDirtiedHandle);
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UNavPathGuideComponent::OnNavigationGenerationFinished);
+    }
+    if (USceneComponent* Root = WatchedRootComponent.Get())
+    {
+        Root->TransformUpdated.Remove(OwnerTransformUpdatedHandle);
+    }
+    WatchedRootComponent.Reset();
+    GroundHeightCache.Invalidate();
+    RouteCache.Invalidate();
+    
+    // Drop our hold on the visual assets; a load still in flight must not call back into a dead component
+    if (VisualAssetsHandle.IsValid())
+    {
+        if (VisualAssetsHandle->IsLoadingInProgress())
+        {
+            VisualAssetsHandle->CancelHandle();
+        }
+        else
+        {
+            VisualAssetsHandle->ReleaseHandle();
+        }
+        VisualAssetsHandle.Reset();
+    }
+    
     // Cancel any pending timers
     if (UWorld* World = GetWorld())
     {
@@ -81,6 +138,67 @@ void UNavPathGuideComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
     Super::EndPlay(EndPlayReason);
 }
 
+/**
+ * Starts loading the soft-referenced visual assets unless they are already in memory
+ */
+bool UNavPathGuideComponent::RequestVisualAssets()
+{
+    // Assets that failed to load are not retried; the visuals skip whatever is missing
+    if (AreVisualAssetsLoaded() || (VisualAssetsHandle.IsValid() && VisualAssetsHandle->HasLoadCompleted()))
+    {
+        return true;
+    }
+    if (VisualAssetsHandle.IsValid() && VisualAssetsHandle->IsLoadingInProgress())
+    {
+        return false;
+    }
+    
+    TArray<FSoftObjectPath> AssetsToLoad;
+    for (const FSoftObjectPath& AssetPath : { PathMesh.ToSoftObjectPath(), ArrowMesh.ToSoftObjectPath(), PathMaterial.ToSoftObjectPath() })
+    {
+        if (!AssetPath.IsNull() && !AssetPath.ResolveObject())
+        {
+            AssetsToLoad.Add(AssetPath);
+        }
+    }
+    
+    VisualAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(AssetsToLoad,
+        FStreamableDelegate::CreateUObject(this, &UNavPathGuideComponent::OnVisualAssetsLoaded));
+    if (!VisualAssetsHandle.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[NavPathGuide] Failed to request the path visual assets."));
+        return false;
+    }
+    return VisualAssetsHandle->HasLoadCompleted();
+}
+
+/**
+ * Checks whether every assigned visual asset is in memory
+ */
+bool UNavPathGuideComponent::AreVisualAssetsLoaded() const
+{
+    return (PathMesh.IsNull() || PathMesh.IsValid())
+        && (ArrowMesh.IsNull() || ArrowMesh.IsValid())
+        && (PathMaterial.IsNull() || PathMaterial.IsValid());
+}
+
+/**
+ * Draws any path that arrived while the visuals were loading
+ */
+void UNavPathGuideComponent::OnVisualAssetsLoaded()
+{
+    if (!AreVisualAssetsLoaded())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[NavPathGuide] Some path visual assets failed to load."));
+    }
+    OnVisualAssetsReady.Broadcast();
+    
+    if (bHasActivePath && bShowNavGuide)
+    {
+        UpdatePathVisuals();
+    }
+}
+
 /**
  * Called every tick when enabled
  * Updates animated path visuals and handles other per-frame updates
@@ -89,18 +207,10 @@ void UNavPathGuideComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 {
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
     
-    // Always update the path if auto update is enabled
-    if (bAutoUpdatePath)
+    // Continue a time-sliced visual rebuild
+    if (IsVisualRebuildPending())
     {
-        UpdatePathIfNeeded();
-    }
-    // Only process tick if we have an active path and the animated style is selected
-    if (bHasActivePath && PathVisualType == EPathVisualType::Animated)
-    {
-        // For animated path type, update visuals with pulsing or flowing effect
-        static float AnimTime = 0.0f;
-        AnimTime += DeltaTime;
-        
+        ProcessVisualRebuildQueue();
     }
 }
 
@@ -137,18 +247,27 @@ void UNavPathGuideComponent::EnsureSplineExists()
 FVector UNavPathGuideComponent::ProjectPointToGround(const FVector& Point, float TraceDistanceOverride, float OffsetAboveGround) const
 {
     float TraceDist = (TraceDistanceOverride > 0.0f) ? TraceDistanceOverride : TraceDistance;
+    const double CurrentTime = GetWorld()->GetTimeSeconds();
+    // Ground that was traced recently in the same cell is reused instead of traced again
+    float CachedGroundZ = 0.0f;
+    if (bUseGroundHeightCache && GroundHeightCache.Find(Point, OffsetAboveGround + GroundCacheMaxStepHeight, CurrentTime, CachedGroundZ))
+    {
+        return FVector(Point.X, Point.Y, CachedGroundZ + OffsetAboveGround);
+    }
     FVector Start = Point + FVector(0, 0, TraceDist * 0.5f);
     FVector End = Point - FVector(0, 0, TraceDist * 0.5f);
     FHitResult HitResult;
     FCollisionQueryParams Params;
     Params.AddIgnoredActor(GetOwner());
     bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, Params);
+    CountGroundTrace();
     if (!bHit)
     {
         // Try a longer downward trace from higher up if initial trace fails
         FVector HighStart = Point + FVector(0, 0, TraceDist);
         FVector FarEnd = Point - FVector(0, 0, TraceDist * 2.0f);
         bHit = GetWorld()->LineTraceSingleByChannel(HitResult, HighStart, FarEnd, ECC_Visibility, Params);
+        CountGroundTrace();
     }
     // Optional: Draw debug line for troubleshooting
     //#define NAVPATHGUIDE_DEBUG
@@ -156,443 +275,2589 @@ FVector UNavPathGuideComponent::ProjectPointToGround(const FVector& Point, float
     DrawDebugLine(GetWorld(), Start, End, FColor::Green, false, 2.0f, 0, 2.0f);
     if (!bHit) DrawDebugLine(GetWorld(), HighStart, FarEnd, FColor::Red, false, 2.0f, 0, 2.0f);
 #endif
-    if (bHit)
+    if (!bHit)
     {
-        return HitResult.ImpactPoint + FVector(0, 0, OffsetAboveGround);
+        // Fallback: try to find the lowest point below (e.g., for holes)
+        FVector DeepStart = Point + FVector(0, 0, 10.0f);
+        FVector DeepEnd = Point - FVector(0, 0, 100000.0f);
+        bHit = GetWorld()->LineTraceSingleByChannel(HitResult, DeepStart, DeepEnd, ECC_Visibility, Params);
+        CountGroundTrace();
     }
-    // Fallback: try to find the lowest point below (e.g., for holes)
-    FVector DeepStart = Point + FVector(0, 0, 10.0f);
-    FVector DeepEnd = Point - FVector(0, 0, 100000.0f);
-    if (GetWorld()->LineTraceSingleByChannel(HitResult, DeepStart, DeepEnd, ECC_Visibility, Params))
+    if (bHit)
     {
+        if (bUseGroundHeightCache)
+        {
+            GroundHeightCache.Store(Point, HitResult.ImpactPoint.Z, CurrentTime);
+        }
         return HitResult.ImpactPoint + FVector(0, 0, OffsetAboveGround);
     }
     return Point; // fallback if no ground found
 }
 
 /**
- * Generates a path to the specified world location
+ * Drops cached ground heights inside an area whose navigation or geometry changed
  */
-bool UNavPathGuideComponent::GeneratePathToLocation(const FVector& Destination)
+void UNavPathGuideComponent::OnNavigationDirtied(const FBox& DirtyBounds)
 {
-    // Clear any existing path
-    ClearPath();
+    GroundHeightCache.InvalidateBox(DirtyBounds);
     
-    // Store the destination for potential path updates
-    PathDestination = Destination;
+    // Routes through the area go now, and again once the rebuild is done in case one was cached in between
+    RouteCache.InvalidateBox(DirtyBounds);
+    PendingNavDirtyBounds += DirtyBounds;
     
-    // Get the navigation system
-    UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
-    if (!NavSystem || !GetOwner())
+    // The path itself is re-planned once the navmesh has been rebuilt
+    if (bHasActivePath && PathBounds.IsValid && PathBounds.Intersect(DirtyBounds))
     {
-        return false;
+        bNavigationChangedOnPath = true;
     }
+}
+
+/**
+ * Re-plans the path once a navmesh rebuild that touched it has finished
+ */
+void UNavPathGuideComponent::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+    // Rebuilt tiles get new polygon refs
+    TrackedNavPoly = INVALID_NAVNODEREF;
+    TrackedNavPolyNeighbors.Reset();
+    RouteCache.InvalidateBox(PendingNavDirtyBounds);
+    PendingNavDirtyBounds.Init();
     
-    // Get the starting position (typically the player's current location)
-    FVector StartLocation = GetOwner()->GetActorLocation();
-    LastPlayerLocation = StartLocation; // Remember where we started
-    
-    // Create a new navigation path
-    CurrentPath = UNavigationSystemV1::FindPathToLocationSynchronously(
-        GetWorld(),
-        StartLocation,
-        PathDestination,
-        GetOwner()
-    );
-    
-    // Check if we found a valid path
-    if (CurrentPath && CurrentPath->IsValid() && CurrentPath->GetPathLength() > 0)
+    if (bNavigationChangedOnPath && bAutoUpdatePath)
     {
-        // Ensure our spline component exists
-        EnsureSplineExists();
-        
-        // Update the spline points based on the path
-        if (PathSpline)
-        {
-            PathSpline->ClearSplinePoints();
-            
-            // Get the original path points
-            const TArray<FNavPathPoint>& PathPoints = CurrentPath->GetPath()->GetPathPoints();
-            TArray<FVector> ProcessedPoints;
-            FVector PlayerCenter = GetOwner()->GetActorLocation();
-            // Only add player center if navmesh start is not close
-            if (PathPoints.Num() > 0 && FVector::Dist(PlayerCenter, PathPoints[0].Location) > 10.0f)
-            {
-                ProcessedPoints.Add(PlayerCenter);
-            }
-            // Add navmesh path points, skipping duplicates/nearby
-            for (int32 i = 0; i < PathPoints.Num(); i++)
-            {
-                FVector CurrentPoint = PathPoints[i].Location;
-                if (ProcessedPoints.Num() == 0 || FVector::Dist(CurrentPoint, ProcessedPoints.Last()) > 1.0f)
-                {
-                    ProcessedPoints.Add(CurrentPoint);
-                }
-            }
-            float MinPointDistance = PathWidth * 1.0f;
-            // Remove points that are too close (for visual smoothness)
-            for (int32 i = ProcessedPoints.Num() - 2; i >= 0; --i)
-            {
-                if (FVector::Dist(ProcessedPoints[i], ProcessedPoints[i+1]) < 1.0f)
-                {
-                    ProcessedPoints.RemoveAt(i);
-                }
-            }
-            // Subdivide segments so that no segment exceeds MaxSplineSegmentLength
-            TArray<FVector> SubdividedPoints;
-            if (ProcessedPoints.Num() > 0)
-            {
-                SubdividedPoints.Add(ProjectPointToGround(ProcessedPoints[0], TraceDistance, PathHeightOffset));
-                for (int32 i = 1; i < ProcessedPoints.Num(); ++i)
-                {
-                    FVector Start = ProcessedPoints[i - 1];
-                    FVector End = ProcessedPoints[i];
-                    float SegmentLength = FVector::Dist(Start, End);
-                    int32 NumSegments = FMath::CeilToInt(SegmentLength / MaxSplineSegmentLength);
-                    for (int32 s = 1; s <= NumSegments; ++s)
-                    {
-                        float Alpha = float(s) / float(NumSegments);
-                        FVector Point = FMath::Lerp(Start, End, Alpha);
-                        Point = ProjectPointToGround(Point, TraceDistance, PathHeightOffset);
-                        if (FVector::Dist(Point, SubdividedPoints.Last()) > 1.0f)
-                        {
-                            SubdividedPoints.Add(Point);
-                        }
-                    }
-                }
-            }
-            
-            // Add the subdivided points to the spline
-            // Remove any duplicate or near-duplicate points at the start (fixes disappearing spline near actor)
-            for (int32 i = 0; i < SubdividedPoints.Num(); ++i)
-            {
-                if (i == 0 || FVector::Dist(SubdividedPoints[i], SubdividedPoints[i-1]) > 1.0f)
-                {
-                    PathSpline->AddSplinePoint(SubdividedPoints[i], ESplineCoordinateSpace::World);
-                }
-            }
-            
-            // Update the visual representation of the path
-            UpdatePathVisuals();
-            bHasActivePath = true;
-            
-            return true;
-        }
+        ScheduleAutomaticUpdate();
     }
-    
-    return false;
 }
 
 /**
- * Generates a path to the specified actor
+ * Wakes automatic updates when the owner moves
  */
-bool UNavPathGuideComponent::GeneratePathToActor(AActor* TargetActor)
+void UNavPathGuideComponent::OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
-    if (TargetActor)
+    // Without a path or a destination to return to there is nothing to update
+    if (bAutoUpdatePath && (bHasActivePath || PathDestination != FVector::ZeroVector))
     {
-        return GeneratePathToLocation(TargetActor->GetActorLocation());
+        ScheduleAutomaticUpdate();
     }
-    return false;
 }
 
 /**
- * Updates the visual representation of the path
+ * Schedules one throttled automatic update
  */
-void UNavPathGuideComponent::UpdatePathVisuals()
+void UNavPathGuideComponent::ScheduleAutomaticUpdate()
 {
-    // Ensure we have a spline and mesh
-    if (!PathSpline || !PathMesh)
+    UWorld* World = GetWorld();
+    if (!World)
     {
         return;
     }
-    
-    // Clear any existing spline meshes
-    for (USplineMeshComponent* SplineMesh : SplineMeshes)
-    {
-        if (SplineMesh)
-        {
-            SplineMesh->DestroyComponent();
-        }
-    }
-    SplineMeshes.Empty();
-    
-    // We'll use the PathMaterial directly instead of creating a dynamic instance
-    if (!SharedDynMat && PathMaterial)
+    FTimerManager& TimerManager = World->GetTimerManager();
+    if (TimerManager.TimerExists(UpdatePathTimerHandle))
     {
-        SharedDynMat = UMaterialInstanceDynamic::Create(PathMaterial, this);
-        if (SharedDynMat)
-        {
-            SharedDynMat->SetVectorParameterValue(PathColorParameterName, PathColor);
-            SharedDynMat->SetScalarParameterValue(TEXT("Opacity"), 1.0f);
-        }
+        return; // Movement until then is handled by the update already scheduled
     }
     
-    // Check if the guide should be shown
-    if (!bShowNavGuide)
+    const double Delay = LastAutomaticUpdateTime < 0.0 ? 0.0 : LastAutomaticUpdateTime + UpdateInterval - World->GetTimeSeconds();
+    if (Delay > 0.0)
     {
-        // Hide all spline meshes if the guide is toggled off
-        for (USplineMeshComponent* SplineMesh : SplineMeshes)
-        {
-            if (SplineMesh)
-            {
-                SplineMesh->SetVisibility(false);
-            }
-        }
-        if (PathSpline)
-        {
-            PathSpline->SetVisibility(false);
-        }
-        return;
+        TimerManager.SetTimer(UpdatePathTimerHandle, this, &UNavPathGuideComponent::HandleScheduledUpdate, static_cast<float>(Delay), false);
     }
     else
     {
-        for (USplineMeshComponent* SplineMesh : SplineMeshes)
-        {
-            if (SplineMesh)
-            {
-                SplineMesh->SetVisibility(true);
-            }
-        }
-        if (PathSpline)
-        {
-            PathSpline->SetVisibility(true);
-        }
-    }
-    
-    // Get number of spline points
-    int32 NumPoints = PathSpline->GetNumberOfSplinePoints();
-    if (NumPoints < 2)
-    {
-        return; // Need at least 2 points for a path segment
-    }
-
-    // Control the maximum segment length for spline meshes
-    float MaxSegmentLength = MaxSplineSegmentLength; // Use the UPROPERTY from the header
-    int32 StartIndex = 0;
-    while (StartIndex < NumPoints - 1)
-    {
-        float SegmentLength = 0.0f;
-        int32 EndIndex = StartIndex + 1;
-        // Find the furthest point within MaxSegmentLength
-        while (EndIndex < NumPoints)
-        {
-            SegmentLength = PathSpline->GetDistanceAlongSplineAtSplinePoint(EndIndex) - PathSpline->GetDistanceAlongSplineAtSplinePoint(StartIndex);
-            if (SegmentLength > MaxSegmentLength)
-            {
-                EndIndex--;
-                break;
-            }
-            EndIndex++;
-        }
-        if (EndIndex >= NumPoints) EndIndex = NumPoints - 1;
-        if (EndIndex == StartIndex) EndIndex = StartIndex + 1;
-
-        UpdateSplineMesh(StartIndex);
-        StartIndex = EndIndex;
+        // Never update from inside the movement callback itself
+        UpdatePathTimerHandle = TimerManager.SetTimerForNextTick(this, &UNavPathGuideComponent::HandleScheduledUpdate);
     }
 }
 
 /**
- * Creates or updates a spline mesh at the given index
+ * Runs one automatic update
  */
-void UNavPathGuideComponent::UpdateSplineMesh(int32 SegmentIndex)
+void UNavPathGuideComponent::HandleScheduledUpdate()
 {
-    if (!PathSpline || !PathMesh) return;
-    if (SegmentIndex < 0 || SegmentIndex >= PathSpline->GetNumberOfSplinePoints() - 1) return;
-
-    FVector StartPos = PathSpline->GetLocationAtSplinePoint(SegmentIndex, ESplineCoordinateSpace::World);
-    FVector EndPos = PathSpline->GetLocationAtSplinePoint(SegmentIndex + 1, ESplineCoordinateSpace::World);
-    FVector StartTangent = PathSpline->GetTangentAtSplinePoint(SegmentIndex, ESplineCoordinateSpace::World);
-    FVector EndTangent = PathSpline->GetTangentAtSplinePoint(SegmentIndex + 1, ESplineCoordinateSpace::World);
-
-    // Snap both start and end to ground
-    StartPos = ProjectPointToGround(StartPos, TraceDistance, PathHeightOffset);
-    EndPos = ProjectPointToGround(EndPos, TraceDistance, PathHeightOffset);
-
-    // Recalculate tangents to follow the ground exactly
-    FVector SegmentDirection = (EndPos - StartPos).GetSafeNormal();
-    float StartTangentLength = (PathSpline->GetTangentAtSplinePoint(SegmentIndex, ESplineCoordinateSpace::World)).Size();
-    float EndTangentLength = (PathSpline->GetTangentAtSplinePoint(SegmentIndex + 1, ESplineCoordinateSpace::World)).Size();
-    StartTangent = SegmentDirection * StartTangentLength;
-    EndTangent = SegmentDirection * EndTangentLength;
-
-    USplineMeshComponent* SplineMesh = nullptr;
-    if (SegmentIndex < SplineMeshes.Num())
-    {
-        SplineMesh = SplineMeshes[SegmentIndex];
-    }
-    else
-    {
-        SplineMesh = NewObject<USplineMeshComponent>(GetOwner());
-        SplineMesh->SetMobility(EComponentMobility::Movable);
-        SplineMesh->SetStaticMesh(PathMesh);
-        SplineMesh->RegisterComponent();
-        SplineMeshes.Add(SplineMesh);
-    }
-
-    // Set the width/scale of the spline mesh based on PathWidth, but use a much smaller multiplier for better visual fit
-    float WidthScale = PathWidth * 0.04f; // Make the path even thinner
-    FVector2D MeshScale(WidthScale, WidthScale);
-    SplineMesh->SetStartScale(MeshScale);
-    SplineMesh->SetEndScale(MeshScale);
-    // Center the mesh by offsetting it along the right vector
-    FVector MeshOffset = FVector::ZeroVector;
-    if (PathMesh)
+    UpdatePathTimerHandle.Invalidate();
+    if (!bAutoUpdatePath)
     {
-        FVector MeshBoundsOrigin, MeshBoundsExtent;
-        PathMesh->GetBounds().GetBox().GetCenterAndExtents(MeshBoundsOrigin, MeshBoundsExtent);
-        MeshOffset = -PathSpline->GetRightVectorAtSplinePoint(SegmentIndex, ESplineCoordinateSpace::World) * MeshBoundsExtent.Y * MeshScale.Y;
+        return;
     }
-    SplineMesh->SetStartAndEnd(StartPos + MeshOffset, StartTangent, EndPos + MeshOffset, EndTangent);
-
-    // Assign the shared dynamic material instance and set color
-    if (SharedDynMat)
+    if (UWorld* World = GetWorld())
     {
-        SplineMesh->SetMaterial(0, SharedDynMat);
-        SplineMesh->SetRenderCustomDepth(true);
-        SplineMesh->SetCustomDepthStencilValue(252);
+        LastAutomaticUpdateTime = World->GetTimeSeconds();
     }
-    else
+    
+    // Wait for the rebuild to finish, or the re-plan would still see the old navmesh
+    const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const bool bNavBuildInProgress = NavSys && NavSys->IsNavigationBuildInProgress();
+    if (bNavigationChangedOnPath && bHasActivePath && !IsPathRequestPending() && !bNavBuildInProgress)
     {
-        UE_LOG(LogTemp, Warning, TEXT("[NavPathGuide] SharedDynMat is null. Spline mesh will have no material assigned!"));
+        // The corridor may still contain the player even though the navmesh under it changed.
+        // A change arriving while this request is in flight sets the flag again.
+        bNavigationChangedOnPath = false;
+        GeneratePathToLocation(PathDestination);
+        return;
     }
-    SplineMesh->SetRenderCustomDepth(true);
-    SplineMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    UpdatePathIfNeeded();
 }
 
 /**
- * Clears the current path and its visual representation
+ * Turns the tick on only while something needs per-frame work
  */
-void UNavPathGuideComponent::ClearPath()
+void UNavPathGuideComponent::RefreshTickEnabled()
 {
-    // Clear the spline points
-    if (PathSpline)
-    {
-        PathSpline->ClearSplinePoints();
-    }
-    
-    // Destroy all spline mesh components
-    for (USplineMeshComponent* SplineMesh : SplineMeshes)
+    const bool bNeedsTick = IsVisualRebuildPending();
+    if (IsComponentTickEnabled() != bNeedsTick)
     {
-        if (SplineMesh)
-        {
-            SplineMesh->DestroyComponent();
-        }
+        SetComponentTickEnabled(bNeedsTick);
     }
-    SplineMeshes.Empty();
-    
-    // Reset path state (do NOT reset PathDestination)
-    CurrentPath = nullptr;
-    bHasActivePath = false;
-    // PathDestination is intentionally NOT reset here, so the guide can regenerate when returning to navmesh
 }
 
 /**
- * Sets the path visual style
+ * Drops every cached route
  */
-void UNavPathGuideComponent::SetPathVisualType(EPathVisualType NewVisualType)
+void UNavPathGuideComponent::InvalidateRouteCache()
 {
-    if (PathVisualType != NewVisualType)
-    {
-        PathVisualType = NewVisualType;
-        
-        // Update visuals if we have an active path
-        if (bHasActivePath)
-        {
-            UpdatePathVisuals();
-        }
-    }
+    RouteCache.Invalidate();
 }
 
 /**
- * Sets the path color
+ * Drops cached ground heights inside the given box
  */
-void UNavPathGuideComponent::SetPathColor(const FLinearColor& NewColor)
+void UNavPathGuideComponent::InvalidateGroundCache(const FBox& Bounds)
+{
+    GroundHeightCache.InvalidateBox(Bounds);
+}
+
+/**
+ * Resets the ground cache hit and miss counters
+ */
+void UNavPathGuideComponent::ResetGroundCacheStats()
+{
+    GroundHeightCache.ResetStats();
+}
+
+/**
+ * Adds up synchronous traces and the async projector's traces
+ */
+int32 UNavPathGuideComponent::GetGroundTraceCount() const
+{
+    return SyncGroundTraceCount + (GroundProjector.IsValid() ? GroundProjector->GetTotalTraceCount() : 0);
+}
+
+/**
+ * Records one synchronous ground trace
+ */
+void UNavPathGuideComponent::CountGroundTrace() const
+{
+    ++SyncGroundTraceCount;
+    INC_DWORD_STAT(STAT_NavPathGuide_GroundTraces);
+    CSV_CUSTOM_STAT(NavPathGuide, GroundTraces, 1, ECsvCustomStatOp::Accumulate);
+}
+
+/**
+ * Changes the ground cache cell size
+ */
+void UNavPathGuideComponent::SetGroundCacheCellSize(float NewCellSize)
+{
+    GroundCacheCellSize = FMath::Max(NewCellSize, 1.0f);
+    GroundHeightCache.SetCellSize(GroundCacheCellSize);
+}
+
+/**
+ * Generates a path to the specified world location
+ */
+bool UNavPathGuideComponent::GeneratePathToLocation(const FVector& Destination)
+{
+    SCOPE_CYCLE_COUNTER(STAT_NavPathGuide_GeneratePath);
+    CSV_SCOPED_TIMING_STAT(NavPathGuide, GeneratePath);
+    
+    // A new request supersedes anything still in flight. The old path itself is only
+    // replaced once the new one is ready, so it stays visible in the async modes.
+    CancelPendingRequests();
+    
+    // Load the visuals alongside the path query; the path is drawn once both are ready
+    RequestVisualAssets();
+    
+    // Store the destination for potential path updates
+    PathDestination = Destination;
+    
+    // Get the navigation system
+    UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    if (!NavSystem || !GetOwner())
+    {
+        ResetPathState();
+        return false;
+    }
+    
+    // Get the starting position (typically the player's current location)
+    FVector StartLocation = GetOwner()->GetActorLocation();
+    LastPlayerLocation = StartLocation; // Remember where we started
+    
+    // Serve repeated routes from memory; a miss is cached once the new path has been committed
+    if (bUseRouteCache)
+    {
+        FNavPathRouteKey RouteKey;
+        FVector NavDestination;
+        if (MakeRouteKey(*NavSystem, StartLocation, PathDestination, RouteKey, NavDestination))
+        {
+            if (const FNavPathRouteEntry* Route = RouteCache.Find(RouteKey))
+            {
+                CommitCachedRoute(*Route, StartLocation, NavDestination);
+                return true;
+            }
+            PendingRouteKey = RouteKey;
+        }
+    }
+    
+    if (bUseAsyncPathfinding)
+    {
+        return RequestAsyncPath(*NavSystem, StartLocation, PathDestination,
+            FNavPathQueryDelegate::CreateUObject(this, &UNavPathGuideComponent::OnAsyncPathFound));
+    }
+    
+    // Create a new navigation path
+    UNavigationPath* FoundPath = UNavigationSystemV1::FindPathToLocationSynchronously(
+        GetWorld(),
+        StartLocation,
+        PathDestination,
+        GetOwner(),
+        NavigationFilterClass
+    );
+    
+    return BuildPathFromNavPath(FoundPath);
+}
+
+/**
+ * Builds the route cache key for a request from the nav polygons at both ends
+ */
+bool UNavPathGuideComponent::MakeRouteKey(UNavigationSystemV1& NavSys, const FVector& Start, const FVector& Destination, FNavPathRouteKey& OutKey, FVector& OutNavDestination)
+{
+    FNavLocation StartNavLocation;
+    FNavLocation EndNavLocation;
+    if (!LocateOnNavmesh(NavSys, Start, StartNavLocation)
+        || !NavSys.ProjectPointToNavigation(Destination, EndNavLocation, FVector(50, 50, 200)))
+    {
+        return false;
+    }
+    OutKey.StartPoly = StartNavLocation.NodeRef;
+    OutKey.EndPoly = EndNavLocation.NodeRef;
+    OutKey.FilterClass = NavigationFilterClass.Get();
+    OutNavDestination = EndNavLocation.Location;
+    return OutKey.IsValid();
+}
+
+/**
+ * Commits a cached route trimmed to the current start and destination
+ */
+void UNavPathGuideComponent::CommitCachedRoute(const FNavPathRouteEntry& Route, const FVector& Start, const FVector& NavDestination)
+{
+    // Both ends lie in the same polygons as when the route was cached, but not necessarily on the same spot.
+    // Finds the segment an end falls on, searching only the stretch of route inside its polygon
+    const TArray<FVector>& RoutePoints = Route.Points;
+    auto FindEndSegment = [&RoutePoints, this](const FVector& Location, int32 FirstSegment, int32 Step)
+    {
+        const int32 NumSegments = RoutePoints.Num() - 1;
+        const float MaxLength = 2.0f * FVector::Dist2D(Location, RoutePoints[Step > 0 ? 0 : NumSegments]) + MaxSplineSegmentLength;
+        int32 BestSegment = FirstSegment;
+        float BestDistanceSquared = UE_MAX_FLT;
+        float Length = 0.0f;
+        for (int32 i = FirstSegment; i >= 0 && i < NumSegments && Length <= MaxLength; i += Step)
+        {
+            const FVector Closest = FMath::ClosestPointOnSegment2D(Location, RoutePoints[i], RoutePoints[i + 1]);
+            const float DistanceSquared = FVector::DistSquared2D(Location, Closest);
+            if (DistanceSquared < BestDistanceSquared)
+            {
+                BestDistanceSquared = DistanceSquared;
+                BestSegment = i;
+            }
+            Length += FVector::Dist(RoutePoints[i], RoutePoints[i + 1]);
+        }
+        return BestSegment;
+    };
+    
+    // Cached points behind the new start or past the new destination would make the path double back on itself
+    const int32 FirstKept = FindEndSegment(Start, 0, 1) + 1;
+    const int32 LastKept = FindEndSegment(NavDestination, RoutePoints.Num() - 2, -1);
+    TArray<FVector> Points;
+    Points.Reserve(RoutePoints.Num() + 2);
+    Points.Add(ProjectPointToGround(Start, TraceDistance, PathHeightOffset));
+    for (int32 i = FirstKept; i <= LastKept; ++i)
+    {
+        Points.Add(RoutePoints[i]);
+    }
+    Points.Add(ProjectPointToGround(NavDestination, TraceDistance, PathHeightOffset));
+    
+    CommitPathPoints(nullptr, Points, Route.CorridorPolys);
+}
+
+/**
+ * Submits an async path query, superseding any query still in flight
+ */
+bool UNavPathGuideComponent::RequestAsyncPath(UNavigationSystemV1& NavSystem, const FVector& StartLocation, const FVector& EndLocation, FNavPathQueryDelegate OnPathFound)
+{
+    // A newer request always wins; the old result would be stale on arrival
+    CancelPendingPathQuery();
+    
+    const INavAgentInterface* NavAgent = Cast<INavAgentInterface>(GetOwner());
+    const FNavAgentProperties& AgentProps = NavAgent ? NavAgent->GetNavAgentPropertiesRef() : FNavAgentProperties::DefaultProperties;
+    
+    const ANavigationData* NavData = NavSystem.GetNavDataForProps(AgentProps, StartLocation);
+    if (!NavData)
+    {
+        NavData = NavSystem.GetDefaultNavDataInstance();
+    }
+    if (!NavData)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("NavPathGuideComponent: No navigation data for async path query."));
+        return false;
+    }
+    
+    FPathFindingQuery Query(GetOwner(), *NavData, StartLocation, EndLocation, UNavigationQueryFilter::GetQueryFilter(*NavData, GetOwner(), NavigationFilterClass));
+    PendingPathQueryId = NavSystem.FindPathAsync(
+        AgentProps,
+        Query,
+        OnPathFound,
+        EPathFindingMode::Regular
+    );
+    
+    return PendingPathQueryId != INVALID_NAVQUERYID;
+}
+
+/**
+ * Receives the result of an async path query and rebuilds the path from it
+ */
+void UNavPathGuideComponent::OnAsyncPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr NavPath)
+{
+    // Drop results from queries that were superseded or cancelled
+    if (QueryId != PendingPathQueryId)
+    {
+        return;
+    }
+    PendingPathQueryId = INVALID_NAVQUERYID;
+    
+    UNavigationPath* FoundPath = nullptr;
+    if (Result == ENavigationQueryResult::Success && NavPath.IsValid())
+    {
+        FoundPath = NewObject<UNavigationPath>(this);
+        FoundPath->SetPath(NavPath);
+    }
+    
+    // The old path is swapped for the new one once it is fully built
+    BuildPathFromNavPath(FoundPath);
+}
+
+/**
+ * Aborts the async path query in flight, if any
+ */
+void UNavPathGuideComponent::CancelPendingPathQuery()
+{
+    if (PendingPathQueryId == INVALID_NAVQUERYID)
+    {
+        return;
+    }
+    
+    if (UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSystem->AbortAsyncFindPathRequest(PendingPathQueryId);
+    }
+    PendingPathQueryId = INVALID_NAVQUERYID;
+}
+
+/**
+ * Drops the path query and ground projection batch in flight, if any
+ */
+void UNavPathGuideComponent::CancelPendingRequests()
+{
+    CancelPendingPathQuery();
+    if (GroundProjector.IsValid())
+    {
+        GroundProjector->Cancel();
+    }
+    PendingNavPath = nullptr;
+    PendingGroundPoints.Reset();
+    PendingGroundMissIndices.Reset();
+    PendingRouteKey = FNavPathRouteKey();
+    PendingSpliceCorners.Reset();
+    PendingSpliceCorridorPolys.Reset();
+    bRebuildAfterNavmeshReturnPending = false;
+}
+
+/**
+ * Turns a navigation path result into ground-projected spline points
+ */
+bool UNavPathGuideComponent::BuildPathFromNavPath(UNavigationPath* NavPath)
+{
+    // Check if we found a valid path
+    if (!NavPath || !NavPath->IsValid() || NavPath->GetPathLength() <= 0 || !GetOwner())
+    {
+        if (bRebuildAfterNavmeshReturnPending)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("NavPathGuideComponent: Failed to rebuild path after returning to navmesh."));
+            bRebuildAfterNavmeshReturnPending = false;
+        }
+        ResetPathState();
+        OnPathUpdated.Broadcast(false);
+        return false;
+    }
+    
+    // Get the original path points
+    const TArray<FNavPathPoint>& NavPathPoints = NavPath->GetPath()->GetPathPoints();
+    TArray<FVector> ProcessedPoints;
+    FVector PlayerCenter = GetOwner()->GetActorLocation();
+    // Only add player center if navmesh start is not close
+    if (NavPathPoints.Num() > 0 && FVector::Dist(PlayerCenter, NavPathPoints[0].Location) > 10.0f)
+    {
+        ProcessedPoints.Add(PlayerCenter);
+    }
+    // Add navmesh path points, skipping duplicates/nearby
+    for (int32 i = 0; i < NavPathPoints.Num(); i++)
+    {
+        FVector CurrentPoint = NavPathPoints[i].Location;
+        if (ProcessedPoints.Num() == 0 || FVector::Dist(CurrentPoint, ProcessedPoints.Last()) > 1.0f)
+        {
+            ProcessedPoints.Add(CurrentPoint);
+        }
+    }
+    // Remove points that are too close (for visual smoothness)
+    for (int32 i = ProcessedPoints.Num() - 2; i >= 0; --i)
+    {
+        if (FVector::Dist(ProcessedPoints[i], ProcessedPoints[i+1]) < 1.0f)
+        {
+            ProcessedPoints.RemoveAt(i);
+        }
+    }
+    // Drop corners that don't change the route by more than the tolerance
+    if (bSimplifyPath)
+    {
+        SimplifyPolyline(ProcessedPoints);
+    }
+    // Subdivide segments so that no segment exceeds MaxSplineSegmentLength (or adaptively)
+    TArray<FVector> SubdividedPoints;
+    SubdividePolyline(ProcessedPoints, SubdividedPoints);
+    
+    if (bAsyncGroundProjection)
+    {
+        // Cached cells are resolved right away; only the misses go out in the trace batch
+        TArray<FVector> MissPoints;
+        ResolveCachedGroundHeights(SubdividedPoints, MissPoints);
+        if (MissPoints.Num() == 0)
+        {
+            CommitPathPoints(NavPath, SubdividedPoints);
+            return true;
+        }
+        
+        // Heights are filled in by one async trace batch; the old path stays up until it completes
+        PendingNavPath = NavPath;
+        PendingGroundPoints = MoveTemp(SubdividedPoints);
+        return SubmitGroundProjection(MissPoints,
+            FOnGroundProjectionComplete::CreateUObject(this, &UNavPathGuideComponent::OnGroundProjectionComplete));
+    }
+    
+    for (FVector& Point : SubdividedPoints)
+    {
+        Point = ProjectPointToGround(Point, TraceDistance, PathHeightOffset);
+    }
+    CommitPathPoints(NavPath, SubdividedPoints);
+    return true;
+}
+
+/**
+ * Removes corners whose removal moves the polyline by less than PathSimplifyTolerance (Douglas-Peucker)
+ */
+void UNavPathGuideComponent::SimplifyPolyline(TArray<FVector>& Points) const
+{
+    if (Points.Num() < 3)
+    {
+        return;
+    }
+    
+    // Distances are measured in 3D so corners that carry a height change are kept
+    TBitArray<> Keep(false, Points.Num());
+    Keep[0] = true;
+    Keep[Points.Num() - 1] = true;
+    
+    TArray<TPair<int32, int32>, TInlineAllocator<32>> Ranges;
+    Ranges.Emplace(0, Points.Num() - 1);
+    while (Ranges.Num() > 0)
+    {
+        const TPair<int32, int32> Range = Ranges.Pop(EAllowShrinking::No);
+        float MaxDistance = 0.0f;
+        int32 MaxIndex = INDEX_NONE;
+        for (int32 i = Range.Key + 1; i < Range.Value; ++i)
+        {
+            const float Distance = FMath::PointDistToSegment(Points[i], Points[Range.Key], Points[Range.Value]);
+            if (Distance > MaxDistance)
+            {
+                MaxDistance = Distance;
+                MaxIndex = i;
+            }
+        }
+        if (MaxIndex != INDEX_NONE && MaxDistance > PathSimplifyTolerance)
+        {
+            Keep[MaxIndex] = true;
+            Ranges.Emplace(Range.Key, MaxIndex);
+            Ranges.Emplace(MaxIndex, Range.Value);
+        }
+    }
+    
+    int32 WriteIndex = 0;
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        if (Keep[i])
+        {
+            Points[WriteIndex++] = Points[i];
+        }
+    }
+    Points.SetNum(WriteIndex, EAllowShrinking::No);
+}
+
+/**
+ * Subdivides a polyline into spline points, uniformly or adaptively
+ */
+void UNavPathGuideComponent::SubdividePolyline(const TArray<FVector>& Corners, TArray<FVector>& OutPoints) const
+{
+    OutPoints.Reset();
+    if (Corners.Num() == 0)
+    {
+        return;
+    }
+    OutPoints.Add(Corners[0]);
+    
+    if (!bAdaptiveSubdivision)
+    {
+        for (int32 i = 1; i < Corners.Num(); ++i)
+        {
+            FVector Start = Corners[i - 1];
+            FVector End = Corners[i];
+            float SegmentLength = FVector::Dist(Start, End);
+            int32 NumSegments = FMath::Max(FMath::CeilToInt(SegmentLength / MaxSplineSegmentLength), 1);
+            for (int32 s = 1; s <= NumSegments; ++s)
+            {
+                float Alpha = float(s) / float(NumSegments);
+                OutPoints.Add(FMath::Lerp(Start, End, Alpha));
+            }
+        }
+        return;
+    }
+    
+    // Corners the path turns at by more than AdaptiveCornerAngle
+    const float CornerCos = FMath::Cos(FMath::DegreesToRadians(AdaptiveCornerAngle));
+    auto IsSharpCorner = [&Corners, CornerCos](int32 Index)
+    {
+        if (Index <= 0 || Index >= Corners.Num() - 1)
+        {
+            return false;
+        }
+        const FVector In = (Corners[Index] - Corners[Index - 1]).GetSafeNormal2D();
+        const FVector Out = (Corners[Index + 1] - Corners[Index]).GetSafeNormal2D();
+        return FVector::DotProduct(In, Out) < CornerCos;
+    };
+    
+    // Ground is only probed when it can be traced synchronously; the async batch can't answer mid-build
+    const bool bProbeGround = !bAsyncGroundProjection;
+    for (int32 i = 1; i < Corners.Num(); ++i)
+    {
+        const FVector& Start = Corners[i - 1];
+        const FVector& End = Corners[i];
+        const float SpanLength = FVector::Dist(Start, End);
+        
+        // Keep short segments next to sharp corners so the spline bend stays smooth
+        FVector SpanStart = Start;
+        FVector SpanEnd = End;
+        if (SpanLength > MaxSplineSegmentLength * 2.0f)
+        {
+            const float Alpha = MaxSplineSegmentLength / SpanLength;
+            if (IsSharpCorner(i - 1))
+            {
+                SpanStart = FMath::Lerp(Start, End, Alpha);
+                OutPoints.Add(SpanStart);
+            }
+            if (IsSharpCorner(i))
+            {
+                SpanEnd = FMath::Lerp(Start, End, 1.0f - Alpha);
+            }
+        }
+        AppendAdaptiveSpan(SpanStart, SpanEnd, bProbeGround, 0, OutPoints);
+        if (SpanEnd != End)
+        {
+            OutPoints.Add(End);
+        }
+    }
+}
+
+/**
+ * Appends a span, halving it while it is too long or the ground under it isn't flat enough to skip
+ */
+void UNavPathGuideComponent::AppendAdaptiveSpan(const FVector& Start, const FVector& End, bool bProbeGround, int32 Depth, TArray<FVector>& OutPoints) const
+{
+    static constexpr int32 MaxAdaptiveDepth = 8;
+    const FVector Mid = (Start + End) * 0.5f;
+    const float Length = FVector::Dist(Start, End);
+    
+    bool bSplit = Length > FMath::Max(AdaptiveMaxSegmentLength, MaxSplineSegmentLength);
+    if (!bSplit && bProbeGround && Length > MaxSplineSegmentLength)
+    {
+        // Probes go through the ground cache, so the final projection of these points is a cache hit
+        const float StartZ = ProjectPointToGround(Start, TraceDistance, 0.0f).Z;
+        const float EndZ = ProjectPointToGround(End, TraceDistance, 0.0f).Z;
+        const float MidZ = ProjectPointToGround(Mid, TraceDistance, 0.0f).Z;
+        bSplit = FMath::Abs(MidZ - (StartZ + EndZ) * 0.5f) > PathSimplifyTolerance;
+    }
+    
+    if (bSplit && Depth < MaxAdaptiveDepth)
+    {
+        AppendAdaptiveSpan(Start, Mid, bProbeGround, Depth + 1, OutPoints);
+        AppendAdaptiveSpan(Mid, End, bProbeGround, Depth + 1, OutPoints);
+        return;
+    }
+    OutPoints.Add(End);
+}
+
+/**
+ * Resolves points from the ground height cache and collects the misses for a trace batch
+ */
+void UNavPathGuideComponent::ResolveCachedGroundHeights(TArray<FVector>& Points, TArray<FVector>& OutMissPoints)
+{
+    PendingGroundMissIndices.Reset();
+    const double CurrentTime = GetWorld()->GetTimeSeconds();
+    for (int32 i = 0; i < Points.Num(); ++i)
+    {
+        float CachedGroundZ = 0.0f;
+        if (bUseGroundHeightCache && GroundHeightCache.Find(Points[i], PathHeightOffset + GroundCacheMaxStepHeight, CurrentTime, CachedGroundZ))
+        {
+            Points[i].Z = CachedGroundZ + PathHeightOffset;
+        }
+        else
+        {
+            PendingGroundMissIndices.Add(i);
+            OutMissPoints.Add(Points[i]);
+        }
+    }
+}
+
+/**
+ * Submits the points the cache could not resolve as one async trace batch
+ */
+bool UNavPathGuideComponent::SubmitGroundProjection(const TArray<FVector>& MissPoints, FOnGroundProjectionComplete OnComplete)
+{
+    if (!GroundProjector.IsValid())
+    {
+        GroundProjector = MakeShared<FNavPathGroundProjector>();
+    }
+    
+    FNavPathGroundTraceSettings TraceSettings;
+    TraceSettings.TraceDistance = TraceDistance;
+    TraceSettings.OffsetAboveGround = PathHeightOffset;
+    TraceSettings.QueryParams.AddIgnoredActor(GetOwner());
+    
+    return GroundProjector->Submit(GetWorld(), MissPoints, TraceSettings, MoveTemp(OnComplete));
+}
+
+/**
+ * Merges the traced heights of a batch back into PendingGroundPoints and hands the result over
+ */
+TArray<FVector> UNavPathGuideComponent::MergeGroundProjection(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask)
+{
+    TArray<FVector> GroundPoints = MoveTemp(PendingGroundPoints);
+    
+    // Merge the traced points back in and remember their ground for the next rebuild
+    const double CurrentTime = GetWorld()->GetTimeSeconds();
+    for (int32 i = 0; i < ProjectedPoints.Num() && i < PendingGroundMissIndices.Num(); ++i)
+    {
+        const int32 PointIndex = PendingGroundMissIndices[i];
+        if (!GroundPoints.IsValidIndex(PointIndex))
+        {
+            continue;
+        }
+        if (bUseGroundHeightCache && HitMask[i])
+        {
+            GroundHeightCache.Store(GroundPoints[PointIndex], ProjectedPoints[i].Z - PathHeightOffset, CurrentTime);
+        }
+        GroundPoints[PointIndex] = ProjectedPoints[i];
+    }
+    PendingGroundMissIndices.Reset();
+    return GroundPoints;
+}
+
+/**
+ * Receives the heights of an async ground projection batch
+ */
+void UNavPathGuideComponent::OnGroundProjectionComplete(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask)
+{
+    UNavigationPath* NavPath = PendingNavPath;
+    PendingNavPath = nullptr;
+    CommitPathPoints(NavPath, MergeGroundProjection(ProjectedPoints, HitMask));
+}
+
+/**
+ * Replaces the current path with the given ground-projected points
+ */
+void UNavPathGuideComponent::CommitPathPoints(UNavigationPath* NavPath, const TArray<FVector>& GroundPoints, TConstArrayView<NavNodeRef> RouteCorridorPolys)
+{
+    ResetPathState();
+    CurrentPath = NavPath;
+    
+    // Ensure our spline component exists
+    EnsureSplineExists();
+    if (!PathSpline)
+    {
+        OnPathUpdated.Broadcast(false);
+        return;
+    }
+    
+    // Collect the subdivided points for the spline
+    // Remove any duplicate or near-duplicate points at the start (fixes disappearing spline near actor)
+    PathPoints.Reserve(GroundPoints.Num());
+    for (int32 i = 0; i < GroundPoints.Num(); ++i)
+    {
+        if (i == 0 || FVector::Dist(GroundPoints[i], GroundPoints[i-1]) > 1.0f)
+        {
+            PathPoints.Add(GroundPoints[i]);
+        }
+    }
+    RebuildSplineFromPathPoints();
+    
+    // Index the new path for corridor checks
+    RebuildPathCorridor();
+    AddCorridorPolys(NavPath);
+    CorridorPolys.Append(RouteCorridorPolys);
+    
+    // Remember the finished route for the next request between the same polygons
+    if (PendingRouteKey.IsValid())
+    {
+        RouteCache.Store(PendingRouteKey, PathPoints, CorridorPolys.Array());
+        PendingRouteKey = FNavPathRouteKey();
+    }
+    
+    // Update the visual representation of the path
+    UpdatePathVisuals();
+    bHasActivePath = true;
+    RefreshTickEnabled();
+    OnPathUpdated.Broadcast(true);
+    
+    if (bRebuildAfterNavmeshReturnPending)
+    {
+        UE_LOG(LogTemp, Log, TEXT("NavPathGuideComponent: Path successfully rebuilt."));
+        bRebuildAfterNavmeshReturnPending = false;
+    }
+    
+    // The owner may have moved on while an async request was in flight, and a result planned
+    // before a navmesh change still leaves bNavigationChangedOnPath set so the re-plan follows
+    if (bAutoUpdatePath && (bUseAsyncPathfinding || bAsyncGroundProjection || bNavigationChangedOnPath))
+    {
+        ScheduleAutomaticUpdate();
+    }
+}
+
+/**
+ * Assigns PathPoints to the spline in one operation with analytic tangents
+ */
+void UNavPathGuideComponent::RebuildSplineFromPathPoints()
+{
+    if (!PathSpline)
+    {
+        return;
+    }
+    
+    const int32 NumPoints = PathPoints.Num();
+    PathTangents.SetNumUninitialized(NumPoints, EAllowShrinking::No);
+    
+    // Distance left to the destination, baked into the visuals for the animated pulse
+    PathRemainingDistances.SetNumUninitialized(NumPoints, EAllowShrinking::No);
+    float RemainingDistance = 0.0f;
+    for (int32 i = NumPoints - 1; i >= 0; --i)
+    {
+        if (i < NumPoints - 1)
+        {
+            RemainingDistance += FVector::Dist(PathPoints[i], PathPoints[i + 1]);
+        }
+        PathRemainingDistances[i] = RemainingDistance;
+    }
+    
+    // Catmull-Rom tangents straight from the ground-projected points, one-sided at the ends
+    TArray<FSplinePoint> SplinePoints;
+    SplinePoints.Reserve(NumPoints);
+    const FTransform& SplineTransform = PathSpline->GetComponentTransform();
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        const FVector& Prev = PathPoints[FMath::Max(i - 1, 0)];
+        const FVector& Next = PathPoints[FMath::Min(i + 1, NumPoints - 1)];
+        const float Scale = (i == 0 || i == NumPoints - 1) ? 1.0f : 0.5f;
+        PathTangents[i] = (Next - Prev) * Scale;
+        
+        const FVector LocalTangent = SplineTransform.InverseTransformVector(PathTangents[i]);
+        SplinePoints.Emplace(
+            static_cast<float>(i),
+            SplineTransform.InverseTransformPosition(PathPoints[i]),
+            LocalTangent,
+            LocalTangent,
+            FRotator::ZeroRotator,
+            FVector::OneVector,
+            ESplinePointType::CurveCustomTangent
+        );
+    }
+    
+    // Reparameterize once for the whole path instead of once per inserted point
+    PathSpline->ClearSplinePoints(false);
+    PathSpline->AddPoints(SplinePoints, true);
+}
+
+/**
+ * Generates a path to the specified actor
+ */
+bool UNavPathGuideComponent::GeneratePathToActor(AActor* TargetActor)
+{
+    if (TargetActor)
+    {
+        RequestVisualAssets();
+
+        // Block-to-block routes are precomputed at level start
+        if (GetOwner() && TargetActor->IsA<AWellnessBlock>())
+        {
+            if (const UWellnessRouteTableSubsystem* RouteTable = GetUsableRouteTable())
+            {
+                TArray<FVector> RoutePoints;
+                if (RouteTable->FindRoute(GetOwner()->GetActorLocation(), TargetActor, RoutePoints)
+                    && CommitTableRoute(TargetActor->GetActorLocation(), RoutePoints))
+                {
+                    return true;
+                }
+            }
+        }
+        return GeneratePathToLocation(TargetActor->GetActorLocation());
+    }
+    return false;
+}
+
+/**
+ * Returns the route table only if its routes were planned for the same filter and navigation data as this guide's
+ */
+const UWellnessRouteTableSubsystem* UNavPathGuideComponent::GetUsableRouteTable() const
+{
+    UWorld* World = GetWorld();
+    if (!bUseRouteTable || NavigationFilterClass || !World || !GetOwner())
+    {
+        return nullptr;
+    }
+    const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+    if (!NavSys)
+    {
+        return nullptr;
+    }
+    const INavAgentInterface* NavAgent = Cast<INavAgentInterface>(GetOwner());
+    if (NavAgent && NavSys->GetNavDataForProps(NavAgent->GetNavAgentPropertiesRef(), GetOwner()->GetActorLocation()) != NavSys->GetDefaultNavDataInstance())
+    {
+        return nullptr;
+    }
+    return World->GetSubsystem<UWellnessRouteTableSubsystem>();
+}
+
+/**
+ * Generates a path to the nearest block of a type
+ */
+bool UNavPathGuideComponent::GeneratePathToNearestBlockOfType(EWellnessBlockType BlockType)
+{
+    const UWellnessBlockRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<UWellnessBlockRegistrySubsystem>() : nullptr;
+    if (!Registry || !GetOwner())
+    {
+        return false;
+    }
+    
+    AWellnessBlock* NearestBlock = Registry->FindNearestBlock(GetOwner()->GetActorLocation(), BlockType);
+    if (!NearestBlock)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("NavPathGuideComponent: No wellness block of the requested type is registered."));
+        return false;
+    }
+    return GeneratePathToActor(NearestBlock);
+}
+
+/**
+ * Plans a visiting order for the targets and guides to the first one
+ */
+bool UNavPathGuideComponent::PlanMultiStopRoute(const TArray<AActor*>& Targets)
+{
+    ClearMultiStopRoute();
+    
+    TArray<AActor*> Stops;
+    for (AActor* Target : Targets)
+    {
+        if (IsValid(Target))
+        {
+            Stops.AddUnique(Target);
+        }
+    }
+    if (Stops.Num() == 0 || !GetOwner())
+    {
+        return false;
+    }
+    
+    // Node 0 is the owner; node i + 1 is Stops[i]
+    const int32 NumNodes = Stops.Num() + 1;
+    TArray<float> Costs;
+    Costs.SetNumZeroed(NumNodes * NumNodes);
+    
+    // One metric for the whole matrix: straight-line distance underestimates, so mixing it with route
+    // lengths would favour the pairs whose routes are missing
+    const UWellnessRouteTableSubsystem* RouteTable = GetUsableRouteTable();
+    if (RouteTable && !RouteTable->IsRouteTableReady())
+    {
+        RouteTable = nullptr;
+    }
+    for (int32 Pass = 0; Pass < 2; ++Pass)
+    {
+        bool bAllCostsFound = true;
+        for (int32 From = 0; From < NumNodes && bAllCostsFound; ++From)
+        {
+            for (int32 To = From + 1; To < NumNodes; ++To)
+            {
+                const float Cost = GetTravelCost(RouteTable, From == 0 ? nullptr : Stops[From - 1], Stops[To - 1]);
+                if (Cost < 0.0f)
+                {
+                    bAllCostsFound = false;
+                    break;
+                }
+                Costs[From * NumNodes + To] = Cost;
+                Costs[To * NumNodes + From] = Cost;
+            }
+        }
+        if (bAllCostsFound || !RouteTable)
+        {
+            break;
+        }
+        // Some pair has no route, e.g. the owner is away from every block: fall back to straight lines
+        RouteTable = nullptr;
+    }
+    
+    const TArray<int32> Order = SolveVisitingOrder(Costs, NumNodes);
+    for (int32 i = 1; i < Order.Num(); ++i)
+    {
+        MultiStops.Add(Stops[Order[i] - 1]);
+    }
+    CurrentStopIndex = 0;
+    return GuideToCurrentStop();
+}
+
+/**
+ * Guides to the next planned stop
+ */
+bool UNavPathGuideComponent::AdvanceMultiStopRoute()
+{
+    if (!MultiStops.IsValidIndex(CurrentStopIndex))
+    {
+        return false;
+    }
+    ++CurrentStopIndex;
+    return GuideToCurrentStop();
+}
+
+/**
+ * Forgets the planned stops
+ */
+void UNavPathGuideComponent::ClearMultiStopRoute()
+{
+    MultiStops.Reset();
+    CurrentStopIndex = INDEX_NONE;
+}
+
+/**
+ * The planned stops that still exist, in visiting order
+ */
+TArray<AActor*> UNavPathGuideComponent::GetMultiStopOrder() const
+{
+    TArray<AActor*> Order;
+    for (const TWeakObjectPtr<AActor>& Stop : MultiStops)
+    {
+        if (AActor* StopActor = Stop.Get())
+        {
+            Order.Add(StopActor);
+        }
+    }
+    return Order;
+}
+
+/**
+ * Draws the path to the current stop
+ */
+bool UNavPathGuideComponent::GuideToCurrentStop()
+{
+    while (MultiStops.IsValidIndex(CurrentStopIndex))
+    {
+        if (AActor* Stop = MultiStops[CurrentStopIndex].Get())
+        {
+            // Only the current leg is drawn; block-to-block legs come straight from the route table
+            return GeneratePathToActor(Stop);
+        }
+        ++CurrentStopIndex;
+    }
+    return false;
+}
+
+/**
+ * Travel cost between two planning nodes
+ */
+float UNavPathGuideComponent::GetTravelCost(const UWellnessRouteTableSubsystem* RouteTable, const AActor* FromActor, const AActor* ToActor) const
+{
+    const FVector From = FromActor ? FromActor->GetActorLocation() : GetOwner()->GetActorLocation();
+    if (RouteTable)
+    {
+        return FromActor ? RouteTable->GetRouteLength(FromActor, ToActor) : RouteTable->GetRouteLengthFrom(From, ToActor);
+    }
+    return FVector::Dist(From, ToActor->GetActorLocation());
+}
+
+/**
+ * Nearest-neighbour tour from node 0, improved with 2-opt until no reversal shortens it
+ */
+TArray<int32> UNavPathGuideComponent::SolveVisitingOrder(const TArray<float>& Costs, int32 NumNodes)
+{
+    auto Cost = [&Costs, NumNodes](int32 From, int32 To) { return Costs[From * NumNodes + To]; };
+    
+    TArray<int32> Order;
+    Order.Reserve(NumNodes);
+    Order.Add(0);
+    TBitArray<> Visited(false, NumNodes);
+    Visited[0] = true;
+    for (int32 Step = 1; Step < NumNodes; ++Step)
+    {
+        const int32 Current = Order.Last();
+        int32 Nearest = INDEX_NONE;
+        for (int32 Candidate = 1; Candidate < NumNodes; ++Candidate)
+        {
+            if (!Visited[Candidate] && (Nearest == INDEX_NONE || Cost(Current, Candidate) < Cost(Current, Nearest)))
+            {
+                Nearest = Candidate;
+            }
+        }
+        Visited[Nearest] = true;
+        Order.Add(Nearest);
+    }
+    
+    // 2-opt on an open tour: reversing Order[i..j] swaps edges (i-1, i) and (j, j+1); the last stop has no outgoing edge
+    static constexpr int32 MaxPasses = 32;
+    bool bImproved = true;
+    for (int32 Pass = 0; bImproved && Pass < MaxPasses; ++Pass)
+    {
+        bImproved = false;
+        for (int32 i = 1; i < NumNodes - 1; ++i)
+        {
+            for (int32 j = i + 1; j < NumNodes; ++j)
+            {
+                const bool bHasNext = j + 1 < NumNodes;
+                const float Before = Cost(Order[i - 1], Order[i]) + (bHasNext ? Cost(Order[j], Order[j + 1]) : 0.0f);
+                const float After = Cost(Order[i - 1], Order[j]) + (bHasNext ? Cost(Order[i], Order[j + 1]) : 0.0f);
+                if (After < Before - UE_KINDA_SMALL_NUMBER)
+                {
+                    Algo::Reverse(Order.GetData() + i, j - i + 1);
+                    bImproved = true;
+                }
+            }
+        }
+    }
+    return Order;
+}
+
+/**
+ * Commits a precomputed block-to-block route
+ */
+bool UNavPathGuideComponent::CommitTableRoute(const FVector& Destination, TArray<FVector>& GroundPoints)
+{
+    // The route starts at the block the owner stands next to; lead in from the owner itself,
+    // unless something on the navmesh is in the way and a live query has to find the way around
+    const FVector OwnerLocation = GetOwner()->GetActorLocation();
+    FVector RaycastHit;
+    if (UNavigationSystemV1::NavigationRaycast(this, OwnerLocation, GroundPoints[0], RaycastHit, NavigationFilterClass, GetOwner()))
+    {
+        return false;
+    }
+    
+    CancelPendingRequests();
+    PathDestination = Destination;
+    LastPlayerLocation = OwnerLocation;
+    
+    for (FVector& Point : GroundPoints)
+    {
+        Point.Z += PathHeightOffset;
+    }
+    const FVector OwnerPoint = ProjectPointToGround(LastPlayerLocation, TraceDistance, PathHeightOffset);
+    if (FVector::Dist(OwnerPoint, GroundPoints[0]) > 10.0f)
+    {
+        GroundPoints.Insert(OwnerPoint, 0);
+    }
+    CommitPathPoints(nullptr, GroundPoints);
+    return true;
+}
+
+/**
+ * Updates the visual representation of the path
+ */
+void UNavPathGuideComponent::UpdatePathVisuals()
+{
+    SCOPE_CYCLE_COUNTER(STAT_NavPathGuide_UpdatePathVisuals);
+    CSV_SCOPED_TIMING_STAT(NavPathGuide, UpdatePathVisuals);
+    
+    // Ensure we have a spline and mesh (the ribbon generates its own geometry)
+    const bool bUseRibbon = PathVisualType == EPathVisualType::Ribbon;
+    if (!PathSpline)
+    {
+        return;
+    }
+    
+    // Nothing can be drawn until the soft-referenced visuals are in; OnVisualAssetsLoaded redraws the path
+    if (!RequestVisualAssets())
+    {
+        return;
+    }
+    if (!PathMesh && !bUseRibbon)
+    {
+        return;
+    }
+    
+    // Return every spline mesh to the pool; the rebuild below reacquires as many as it needs
+    ActiveSplineMeshCount = 0;
+    CancelVisualRebuild();
+    
+    // We'll use the PathMaterial directly instead of creating a dynamic instance
+    if (!SharedDynMat && PathMaterial)
+    {
+        SharedDynMat = UMaterialInstanceDynamic::Create(PathMaterial.Get(), this);
+        if (SharedDynMat)
+        {
+            SharedDynMat->SetVectorParameterValue(PathColorParameterName, PathColor);
+            SharedDynMat->SetScalarParameterValue(TEXT("Opacity"), 1.0f);
+            ApplyPulseParameters();
+        }
+    }
+    
+    // Check if the guide should be shown
+    if (!bShowNavGuide)
+    {
+        // Hide all spline meshes if the guide is toggled off
+        ReleaseUnusedSplineMeshes();
+        if (PathRibbon)
+        {
+            PathRibbon->SetVisibility(false);
+        }
+        if (PathSpline)
+        {
+            PathSpline->SetVisibility(false);
+        }
+        return;
+    }
+    else
+    {
+        if (PathSpline)
+        {
+            PathSpline->SetVisibility(true);
+        }
+    }
+    
+    // Get number of spline points
+    int32 NumPoints = PathSpline->GetNumberOfSplinePoints();
+    if (NumPoints < 2)
+    {
+        ReleaseUnusedSplineMeshes();
+        return; // Need at least 2 points for a path segment
+    }
+
+    // The ribbon draws the whole path as one primitive, so no spline meshes are needed
+    if (bUseRibbon)
+    {
+        ReleaseUnusedSplineMeshes();
+        UpdateRibbonMesh();
+        return;
+    }
+    if (PathRibbon)
+    {
+        PathRibbon->SetVisibility(false);
+    }
+
+    // One pooled spline mesh per spline segment, so segment i always maps to SplineMeshes[i]
+    ActiveSplineMeshCount = NumPoints - 1;
+    SegmentLODs.Reset();
+    SegmentLODs.SetNumZeroed(ActiveSplineMeshCount);
+    if (GetOwner())
+    {
+        SetLODOrigin(GetOwnerFeetLocation());
+    }
+    
+    // Hide whatever the previous, longer path used
+    ReleaseUnusedSplineMeshes();
+    
+    if (bTimeSliceVisualRebuild)
+    {
+        // Segments near the player go first; the rest follow on later ticks
+        // Queued segments compute their parameters as they are reached
+        SegmentBuffer.Init(ActiveSplineMeshCount);
+        QueueVisualRebuild();
+        ProcessVisualRebuildQueue();
+        return;
+    }
+    
+    // Compute every full-detail run of segments in one pass, then apply them to the meshes
+    SegmentBuffer.Init(ActiveSplineMeshCount);
+    int32 RunStart = INDEX_NONE;
+    for (int32 SegmentIndex = 0; SegmentIndex <= ActiveSplineMeshCount; ++SegmentIndex)
+    {
+        int32 SpanEnd = 0;
+        const bool bFullDetail = SegmentIndex < ActiveSplineMeshCount && ComputeSegmentLOD(SegmentIndex, SpanEnd) == ENavPathSegmentLOD::Full;
+        if (bFullDetail && RunStart == INDEX_NONE)
+        {
+            RunStart = SegmentIndex;
+        }
+        else if (!bFullDetail && RunStart != INDEX_NONE)
+        {
+            BuildSegmentBuffer(RunStart, SegmentIndex - 1);
+            RunStart = INDEX_NONE;
+        }
+    }
+    for (int32 SegmentIndex = 0; SegmentIndex < ActiveSplineMeshCount; ++SegmentIndex)
+    {
+        UpdateSegmentVisual(SegmentIndex);
+    }
+}
+
+/**
+ * Picks a segment's detail level from its path distance to the owner
+ */
+ENavPathSegmentLOD UNavPathGuideComponent::ComputeSegmentLOD(int32 SegmentIndex, int32& OutSpanEnd) const
+{
+    OutSpanEnd = SegmentIndex + 1;
+    const int32 NumSegments = ActiveSplineMeshCount;
+    if (!bUsePathLOD || PathRemainingDistances.Num() != NumSegments + 1)
+    {
+        return ENavPathSegmentLOD::Full;
+    }
+    
+    // Groups are counted from the destination, so trimming the head of the path leaves them unchanged
+    const int32 Stride = FMath::Max(LODCoarseStride, 1);
+    const int32 Group = (NumSegments - 1 - SegmentIndex) / Stride;
+    const int32 GroupStart = FMath::Max(NumSegments - (Group + 1) * Stride, 0);
+    const int32 GroupEnd = NumSegments - Group * Stride;
+    
+    const float Distance = FMath::Abs(LODOriginDistance - PathRemainingDistances[GroupStart]);
+    if (Distance < LODFullDetailDistance)
+    {
+        return ENavPathSegmentLOD::Full;
+    }
+    if (Distance >= LODCoarseDistance)
+    {
+        return ENavPathSegmentLOD::Hidden;
+    }
+    if (SegmentIndex != GroupStart)
+    {
+        return ENavPathSegmentLOD::Merged;
+    }
+    OutSpanEnd = GroupEnd;
+    return ENavPathSegmentLOD::Coarse;
+}
+
+/**
+ * Builds a segment at its LOD
+ */
+void UNavPathGuideComponent::UpdateSegmentVisual(int32 SegmentIndex)
+{
+    int32 SpanEnd = SegmentIndex + 1;
+    const ENavPathSegmentLOD LOD = ComputeSegmentLOD(SegmentIndex, SpanEnd);
+    if (SegmentLODs.Num() < ActiveSplineMeshCount)
+    {
+        SegmentLODs.SetNumZeroed(ActiveSplineMeshCount);
+    }
+    SegmentLODs[SegmentIndex] = LOD;
+    
+    switch (LOD)
+    {
+    case ENavPathSegmentLOD::Full:
+        UpdateSplineMesh(SegmentIndex);
+        break;
+    case ENavPathSegmentLOD::Coarse:
+        UpdateCoarseSplineMesh(SegmentIndex, SpanEnd);
+        break;
+    default:
+        // Merged into its group's mesh, or too far to draw
+        if (SplineMeshes.IsValidIndex(SegmentIndex) && SplineMeshes[SegmentIndex] && SplineMeshes[SegmentIndex]->IsVisible())
+        {
+            SplineMeshes[SegmentIndex]->SetVisibility(false);
+        }
+        break;
+    }
+}
+
+/**
+ * Draws one straight, untraced mesh over a group of segments
+ */
+void UNavPathGuideComponent::UpdateCoarseSplineMesh(int32 SegmentIndex, int32 EndPointIndex)
+{
+    if (!PathMesh || !PathPoints.IsValidIndex(SegmentIndex) || !PathPoints.IsValidIndex(EndPointIndex))
+    {
+        return;
+    }
+    
+    // Path points are already on the ground, so far segments skip the endpoint traces
+    const FVector& StartPos = PathPoints[SegmentIndex];
+    const FVector& EndPos = PathPoints[EndPointIndex];
+    const FVector Tangent = EndPos - StartPos;
+    
+    USplineMeshComponent* SplineMesh = AcquireSplineMesh(SegmentIndex);
+    SplineMesh->SetStaticMesh(PathMesh.Get());
+    
+    const float WidthScale = PathWidth * 0.04f;
+    const FVector2D MeshScale(WidthScale, WidthScale);
+    SplineMesh->SetStartScale(MeshScale);
+    SplineMesh->SetEndScale(MeshScale);
+    const FVector Right = FVector::CrossProduct(FVector::UpVector, Tangent.GetSafeNormal2D());
+    const FVector MeshOffset = -Right * SegmentBuffer.GetMeshHalfWidth(PathMesh.Get()) * MeshScale.Y;
+    SplineMesh->SetStartAndEnd(StartPos + MeshOffset, Tangent, EndPos + MeshOffset, Tangent);
+    
+    if (PathRemainingDistances.IsValidIndex(EndPointIndex))
+    {
+        SplineMesh->SetCustomPrimitiveDataFloat(0, PathRemainingDistances[SegmentIndex]);
+        SplineMesh->SetCustomPrimitiveDataFloat(1, PathRemainingDistances[SegmentIndex] - PathRemainingDistances[EndPointIndex]);
+    }
+    if (SharedDynMat && SplineMesh->GetMaterial(0) != SharedDynMat)
+    {
+        SplineMesh->SetMaterial(0, SharedDynMat);
+    }
+    // The outline pass is only worth it close to the player
+    SplineMesh->SetRenderCustomDepth(false);
+}
+
+/**
+ * Measures LOD distances from the owner's place on the path
+ */
+void UNavPathGuideComponent::SetLODOrigin(const FVector& OwnerLocation)
+{
+    float DistanceSquared = 0.0f;
+    const int32 NearestSegment = FindNearestPathSegment(OwnerLocation, CorridorRadius, DistanceSquared);
+    LODOriginDistance = PathRemainingDistances.IsValidIndex(NearestSegment) ? PathRemainingDistances[NearestSegment]
+        : (PathRemainingDistances.Num() > 0 ? PathRemainingDistances[0] : 0.0f);
+}
+
+/**
+ * Rebuilds the segments whose LOD changed as the owner moved along the path
+ */
+void UNavPathGuideComponent::RefreshPathLOD(const FVector& OwnerLocation)
+{
+    if (!bUsePathLOD || !bShowNavGuide || PathVisualType == EPathVisualType::Ribbon
+        || IsVisualRebuildPending() || ActiveSplineMeshCount != PathPoints.Num() - 1)
+    {
+        return;
+    }
+    
+    SetLODOrigin(OwnerLocation);
+    for (int32 SegmentIndex = 0; SegmentIndex < ActiveSplineMeshCount; ++SegmentIndex)
+    {
+        int32 SpanEnd = 0;
+        if (!SegmentLODs.IsValidIndex(SegmentIndex) || ComputeSegmentLOD(SegmentIndex, SpanEnd) != SegmentLODs[SegmentIndex])
+        {
+            UpdateSegmentVisual(SegmentIndex);
+        }
+    }
+}
+
+/**
+ * Queues all active segments for a time-sliced rebuild, nearest to the owner first
+ */
+void UNavPathGuideComponent::QueueVisualRebuild()
+{
+    VisualRebuildQueue.Reset();
+    VisualRebuildCursor = 0;
+    if (ActiveSplineMeshCount <= 0)
+    {
+        return;
+    }
+    
+    int32 NearestSegment = 0;
+    if (GetOwner() && PathPoints.Num() - 1 == ActiveSplineMeshCount)
+    {
+        float DistanceSquared = 0.0f;
+        NearestSegment = FMath::Max(FindNearestPathSegment(GetOwnerFeetLocation(), CorridorRadius, DistanceSquared), 0);
+    }
+    
+    // The player looks ahead along the path, so segments behind the nearest one come last
+    VisualRebuildQueue.Reserve(ActiveSplineMeshCount);
+    for (int32 SegmentIndex = NearestSegment; SegmentIndex < ActiveSplineMeshCount; ++SegmentIndex)
+    {
+        VisualRebuildQueue.Add(SegmentIndex);
+    }
+    for (int32 SegmentIndex = NearestSegment - 1; SegmentIndex >= 0; --SegmentIndex)
+    {
+        VisualRebuildQueue.Add(SegmentIndex);
+    }
+    
+    // Pooled meshes still show the old path's segments; each one reappears once its new segment is built
+    for (int32 SegmentIndex = 0; SegmentIndex < FMath::Min(ActiveSplineMeshCount, SplineMeshes.Num()); ++SegmentIndex)
+    {
+        if (SplineMeshes[SegmentIndex] && SplineMeshes[SegmentIndex]->IsVisible())
+        {
+            SplineMeshes[SegmentIndex]->SetVisibility(false);
+        }
+    }
+}
+
+/**
+ * Builds queued segments within the per-frame budget
+ */
+void UNavPathGuideComponent::ProcessVisualRebuildQueue()
+{
+    const double Deadline = FPlatformTime::Seconds() + VisualRebuildBudgetMs * 0.001;
+    while (IsVisualRebuildPending())
+    {
+        const int32 SegmentIndex = VisualRebuildQueue[VisualRebuildCursor++];
+        if (SegmentIndex < ActiveSplineMeshCount)
+        {
+            UpdateSegmentVisual(SegmentIndex);
+        }
+        // Always build at least one segment so the rebuild makes progress under any budget
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+    if (!IsVisualRebuildPending())
+    {
+        CancelVisualRebuild();
+    }
+    else
+    {
+        RefreshTickEnabled();
+    }
+}
+
+/**
+ * Drops the rest of a time-sliced rebuild
+ */
+void UNavPathGuideComponent::CancelVisualRebuild()
+{
+    VisualRebuildQueue.Reset();
+    VisualRebuildCursor = 0;
+    RefreshTickEnabled();
+}
+
+/**
+ * Rebuilds the single-draw ribbon from the spline points, updating the vertex buffer in place when the topology is unchanged
+ */
+void UNavPathGuideComponent::UpdateRibbonMesh()
+{
+    const int32 NumPoints = PathSpline ? PathSpline->GetNumberOfSplinePoints() : 0;
+    if (NumPoints < 2 || !GetOwner())
+    {
+        return;
+    }
+    
+    if (!PathRibbon)
+    {
+        PathRibbon = NewObject<UProceduralMeshComponent>(GetOwner(), TEXT("PathRibbon"));
+        PathRibbon->SetMobility(EComponentMobility::Movable);
+        PathRibbon->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        PathRibbon->SetCastShadow(false);
+        PathRibbon->RegisterComponent();
+        // Vertices are written in world space, so keep the ribbon at the origin
+        PathRibbon->SetWorldTransform(FTransform::Identity);
+    }
+    
+    // Match the footprint of the spline mesh path
+    float HalfWidth = PathWidth * 0.04f * 50.0f;
+    if (PathMesh)
+    {
+        HalfWidth = SegmentBuffer.GetMeshHalfWidth(PathMesh.Get()) * PathWidth * 0.04f;
+    }
+    
+    // Two vertices per spline point, left and right of the path
+    const int32 NumVertices = NumPoints * 2;
+    RibbonVertices.SetNumUninitialized(NumVertices, EAllowShrinking::No);
+    RibbonNormals.SetNumUninitialized(NumVertices, EAllowShrinking::No);
+    RibbonUVs.SetNumUninitialized(NumVertices, EAllowShrinking::No);
+    RibbonDistanceUVs.SetNumUninitialized(NumVertices, EAllowShrinking::No);
+    RibbonTangents.SetNum(NumVertices, EAllowShrinking::No);
+    
+    float DistanceAlongPath = 0.0f;
+    FVector PreviousPoint = PathSpline->GetLocationAtSplinePoint(0, ESplineCoordinateSpace::World);
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        const FVector Point = PathSpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
+        const FVector Prev = PathSpline->GetLocationAtSplinePoint(FMath::Max(i - 1, 0), ESplineCoordinateSpace::World);
+        const FVector Next = PathSpline->GetLocationAtSplinePoint(FMath::Min(i + 1, NumPoints - 1), ESplineCoordinateSpace::World);
+        FVector Direction = (Next - Prev).GetSafeNormal2D();
+        if (Direction.IsNearlyZero())
+        {
+            Direction = FVector::ForwardVector;
+        }
+        const FVector Right = FVector::CrossProduct(FVector::UpVector, Direction);
+        
+        DistanceAlongPath += FVector::Dist(PreviousPoint, Point);
+        PreviousPoint = Point;
+        const float V = DistanceAlongPath / FMath::Max(HalfWidth * 2.0f, 1.0f);
+        
+        RibbonVertices[i * 2] = Point - Right * HalfWidth;
+        RibbonVertices[i * 2 + 1] = Point + Right * HalfWidth;
+        RibbonNormals[i * 2] = FVector::UpVector;
+        RibbonNormals[i * 2 + 1] = FVector::UpVector;
+        RibbonUVs[i * 2] = FVector2D(0.0f, V);
+        RibbonUVs[i * 2 + 1] = FVector2D(1.0f, V);
+        const float Remaining = PathRemainingDistances.IsValidIndex(i) ? PathRemainingDistances[i] : 0.0f;
+        RibbonDistanceUVs[i * 2] = FVector2D(Remaining, 0.0f);
+        RibbonDistanceUVs[i * 2 + 1] = FVector2D(Remaining, 0.0f);
+        RibbonTangents[i * 2] = FProcMeshTangent(Direction, false);
+        RibbonTangents[i * 2 + 1] = FProcMeshTangent(Direction, false);
+    }
+    
+    static const TArray<FColor> NoVertexColors;
+    static const TArray<FVector2D> NoUVs;
+    if (RibbonSectionVertexCount == NumVertices)
+    {
+        // Same topology as last time - only the vertex data changes
+        PathRibbon->UpdateMeshSection(0, RibbonVertices, RibbonNormals, RibbonUVs, RibbonDistanceUVs, NoUVs, NoUVs, NoVertexColors, RibbonTangents);
+    }
+    else
+    {
+        // Two triangles per quad, wound so the ribbon faces up
+        TArray<int32> Triangles;
+        Triangles.Reserve((NumPoints - 1) * 6);
+        for (int32 i = 0; i < NumPoints - 1; ++i)
+        {
+            const int32 Left = i * 2;
+            const int32 Right = i * 2 + 1;
+            const int32 NextLeft = Left + 2;
+            const int32 NextRight = Right + 2;
+            Triangles.Add(Left);
+            Triangles.Add(Right);
+            Triangles.Add(NextLeft);
+            Triangles.Add(Right);
+            Triangles.Add(NextRight);
+            Triangles.Add(NextLeft);
+        }
+        PathRibbon->CreateMeshSection(0, RibbonVertices, Triangles, RibbonNormals, RibbonUVs, RibbonDistanceUVs, NoUVs, NoUVs, NoVertexColors, RibbonTangents, false);
+        RibbonSectionVertexCount = NumVertices;
+    }
+    
+    if (SharedDynMat && PathRibbon->GetMaterial(0) != SharedDynMat)
+    {
+        PathRibbon->SetMaterial(0, SharedDynMat);
+    }
+    PathRibbon->SetRenderCustomDepth(true);
+    PathRibbon->SetCustomDepthStencilValue(252);
+    PathRibbon->SetVisibility(true);
+}
+
+/**
+ * Returns the pooled spline mesh for a segment, creating one only when the pool has no mesh in that slot
+ */
+USplineMeshComponent* UNavPathGuideComponent::AcquireSplineMesh(int32 SegmentIndex)
+{
+    if (SplineMeshes.Num() <= SegmentIndex)
+    {
+        SplineMeshes.SetNum(SegmentIndex + 1);
+    }
+    
+    USplineMeshComponent* SplineMesh = SplineMeshes[SegmentIndex];
+    if (SplineMesh)
+    {
+        if (!SplineMesh->IsVisible())
+        {
+            SplineMesh->SetVisibility(true);
+        }
+    }
+    else
+    {
+        SplineMesh = NewObject<USplineMeshComponent>(GetOwner());
+        SplineMesh->SetMobility(EComponentMobility::Movable);
+        SplineMesh->SetStaticMesh(PathMesh.Get());
+        SplineMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        SplineMesh->RegisterComponent();
+        SplineMeshes[SegmentIndex] = SplineMesh;
+    }
+    return SplineMesh;
+}
+
+/**
+ * Hides pooled spline meshes past the active count and trims the pool to its cap
+ */
+void UNavPathGuideComponent::ReleaseUnusedSplineMeshes()
+{
+    for (int32 i = SplineMeshes.Num() - 1; i >= ActiveSplineMeshCount; --i)
+    {
+        USplineMeshComponent* SplineMesh = SplineMeshes[i];
+        if (i >= MaxPooledSplineMeshes)
+        {
+            if (SplineMesh)
+            {
+                SplineMesh->DestroyComponent();
+            }
+            SplineMeshes.RemoveAt(i, 1, EAllowShrinking::No);
+        }
+        else if (SplineMesh && SplineMesh->IsVisible())
+        {
+            SplineMesh->SetVisibility(false);
+        }
+    }
+}
+
+/**
+ * Destroys every pooled spline mesh
+ */
+void UNavPathGuideComponent::DestroySplineMeshPool()
+{
+    for (USplineMeshComponent* SplineMesh : SplineMeshes)
+    {
+        if (SplineMesh)
+        {
+            SplineMesh->DestroyComponent();
+        }
+    }
+    SplineMeshes.Empty();
+    ActiveSplineMeshCount = 0;
+}
+
+/**
+ * Creates or updates a spline mesh at the given index
+ */
+void UNavPathGuideComponent::UpdateSplineMesh(int32 SegmentIndex)
+{
+    if (!PathSpline || !PathMesh) return;
+    if (SegmentIndex < 0 || SegmentIndex >= PathSpline->GetNumberOfSplinePoints() - 1) return;
+
+    // Segments outside a batched rebuild (time-sliced, spliced, re-detailed) compute their parameters here
+    if (!SegmentBuffer.IsBuilt(SegmentIndex))
+    {
+        BuildSegmentBuffer(SegmentIndex, SegmentIndex);
+    }
+
+    USplineMeshComponent* SplineMesh = AcquireSplineMesh(SegmentIndex);
+    SplineMesh->SetStaticMesh(PathMesh.Get()); // No-op unless the mesh changed since the component was pooled
+
+    const FVector2D& MeshScale = SegmentBuffer.Scales[SegmentIndex];
+    SplineMesh->SetStartScale(MeshScale);
+    SplineMesh->SetEndScale(MeshScale);
+    const FVector& MeshOffset = SegmentBuffer.Offsets[SegmentIndex];
+    SplineMesh->SetStartAndEnd(SegmentBuffer.StartPositions[SegmentIndex] + MeshOffset, SegmentBuffer.StartTangents[SegmentIndex],
+        SegmentBuffer.EndPositions[SegmentIndex] + MeshOffset, SegmentBuffer.EndTangents[SegmentIndex]);
+    
+    // Bake the segment's place on the path once; the material animates the pulse from it
+    if (PathRemainingDistances.IsValidIndex(SegmentIndex + 1))
+    {
+        SplineMesh->SetCustomPrimitiveDataFloat(0, PathRemainingDistances[SegmentIndex]);
+        SplineMesh->SetCustomPrimitiveDataFloat(1, PathRemainingDistances[SegmentIndex] - PathRemainingDistances[SegmentIndex + 1]);
+    }
+
+    // Assign the shared dynamic material instance and set color
+    if (SharedDynMat)
+    {
+        // Pooled meshes usually already carry the shared material
+        if (SplineMesh->GetMaterial(0) != SharedDynMat)
+        {
+            SplineMesh->SetMaterial(0, SharedDynMat);
+        }
+        SplineMesh->SetCustomDepthStencilValue(252);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("[NavPathGuide] SharedDynMat is null. Spline mesh will have no material assigned!"));
+    }
+    SplineMesh->SetRenderCustomDepth(true);
+    SplineMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+}
+
+/**
+ * Computes segment endpoints, tangents, offsets and scales for a range of segments
+ */
+void UNavPathGuideComponent::BuildSegmentBuffer(int32 FirstSegment, int32 LastSegment)
+{
+    const int32 NumSegments = PathSpline ? PathSpline->GetNumberOfSplinePoints() - 1 : 0;
+    if (SegmentBuffer.Num() != NumSegments)
+    {
+        SegmentBuffer.Init(NumSegments);
+    }
+    FirstSegment = FMath::Max(FirstSegment, 0);
+    LastSegment = FMath::Min(LastSegment, NumSegments - 1);
+    if (FirstSegment > LastSegment)
+    {
+        return;
+    }
+    
+    // First pass: sample each spline point once. Neighbouring segments share the point between them,
+    // so every point is traced once instead of once per segment end
+    const int32 NumRangePoints = LastSegment - FirstSegment + 2;
+    TArray<FVector, TInlineAllocator<64>> Positions;
+    TArray<FVector, TInlineAllocator<64>> RightVectors;
+    TArray<float, TInlineAllocator<64>> TangentLengths;
+    Positions.SetNumUninitialized(NumRangePoints);
+    RightVectors.SetNumUninitialized(NumRangePoints);
+    TangentLengths.SetNumUninitialized(NumRangePoints);
+    for (int32 i = 0; i < NumRangePoints; ++i)
+    {
+        const int32 PointIndex = FirstSegment + i;
+        Positions[i] = PathSpline->GetLocationAtSplinePoint(PointIndex, ESplineCoordinateSpace::World);
+        RightVectors[i] = PathSpline->GetRightVectorAtSplinePoint(PointIndex, ESplineCoordinateSpace::World);
+        TangentLengths[i] = PathSpline->GetTangentAtSplinePoint(PointIndex, ESplineCoordinateSpace::World).Size();
+        
+        // Snap to ground (async-projected points already carry their ground height)
+        if (!bAsyncGroundProjection)
+        {
+            Positions[i] = ProjectPointToGround(Positions[i], TraceDistance, PathHeightOffset);
+        }
+    }
+    
+    // Second pass: plain arithmetic over the contiguous samples
+    const float WidthScale = PathWidth * 0.04f; // Much smaller multiplier than the width for a better visual fit
+    const FVector2D MeshScale(WidthScale, WidthScale);
+    const float OffsetDistance = SegmentBuffer.GetMeshHalfWidth(PathMesh.Get()) * MeshScale.Y;
+    for (int32 i = 0; i < NumRangePoints - 1; ++i)
+    {
+        const int32 SegmentIndex = FirstSegment + i;
+        const FVector& StartPos = Positions[i];
+        const FVector& EndPos = Positions[i + 1];
+        
+        // Tangents follow the ground exactly, keeping the spline's tangent lengths
+        const FVector SegmentDirection = (EndPos - StartPos).GetSafeNormal();
+        SegmentBuffer.StartPositions[SegmentIndex] = StartPos;
+        SegmentBuffer.EndPositions[SegmentIndex] = EndPos;
+        SegmentBuffer.StartTangents[SegmentIndex] = SegmentDirection * TangentLengths[i];
+        SegmentBuffer.EndTangents[SegmentIndex] = SegmentDirection * TangentLengths[i + 1];
+        // Centre the mesh by offsetting it along the right vector
+        SegmentBuffer.Offsets[SegmentIndex] = -RightVectors[i] * OffsetDistance;
+        SegmentBuffer.Scales[SegmentIndex] = MeshScale;
+        SegmentBuffer.MarkBuilt(SegmentIndex);
+    }
+}
+
+/**
+ * Clears the current path and its visual representation
+ */
+void UNavPathGuideComponent::ClearPath()
+{
+    // Any path still being computed would otherwise reappear after the clear
+    CancelPendingRequests();
+    ResetPathState();
+}
+
+/**
+ * Removes the spline points and meshes of the current path
+ */
+void UNavPathGuideComponent::ResetPathState()
+{
+    // Clear the spline points
+    if (PathSpline)
+    {
+        PathSpline->ClearSplinePoints();
+    }
+    
+    // Hide all spline mesh components; they stay registered for the next path
+    ActiveSplineMeshCount = 0;
+    SegmentBuffer.Reset();
+    CancelVisualRebuild();
+    ReleaseUnusedSplineMeshes();
+    
+    // The ribbon keeps its mesh section so the next path can update it in place
+    if (PathRibbon)
+    {
+        PathRibbon->SetVisibility(false);
+    }
+    
+    // Reset path state (do NOT reset PathDestination)
+    PathPoints.Reset();
+    PathTangents.Reset();
+    PathRemainingDistances.Reset();
+    CorridorGrid.Reset();
+    CorridorPolys.Reset();
+    LastCorridorPoly = INVALID_NAVNODEREF;
+    PathBounds.Init();
+    CurrentPath = nullptr;
+    bHasActivePath = false;
+    bNavigationChangedOnPath = false;
+    RefreshTickEnabled();
+    // PathDestination is intentionally NOT reset here, so the guide can regenerate when returning to navmesh
+}
+
+/**
+ * Sets the path visual style
+ */
+void UNavPathGuideComponent::SetPathVisualType(EPathVisualType NewVisualType)
+{
+    if (PathVisualType != NewVisualType)
+    {
+        PathVisualType = NewVisualType;
+        ApplyPulseParameters();
+        
+        // Update visuals if we have an active path
+        if (bHasActivePath)
+        {
+            UpdatePathVisuals();
+        }
+        RefreshTickEnabled();
+    }
+}
+
+/**
+ * Pushes the pulse parameters to the shared material and the parameter collection
+ */
+void UNavPathGuideComponent::ApplyPulseParameters()
+{
+    const float PulseAmount = IsPulseAnimated() ? 1.0f : 0.0f;
+    if (SharedDynMat)
+    {
+        SharedDynMat->SetScalarParameterValue(PulseAmountParameterName, PulseAmount);
+        SharedDynMat->SetScalarParameterValue(PulseSpeedParameterName, PulseSpeed);
+        SharedDynMat->SetScalarParameterValue(PulseSpacingParameterName, PulseSpacing);
+    }
+    if (PathMaterialParameterCollection)
+    {
+        if (UWorld* World = GetWorld())
+        {
+            if (UMaterialParameterCollectionInstance* MPCInst = World->GetParameterCollectionInstance(PathMaterialParameterCollection))
+            {
+                MPCInst->SetScalarParameterValue(PulseAmountParameterName, PulseAmount);
+                MPCInst->SetScalarParameterValue(PulseSpeedParameterName, PulseSpeed);
+                MPCInst->SetScalarParameterValue(PulseSpacingParameterName, PulseSpacing);
+            }
+        }
+    }
+}
+
+/**
+ * Turns the pulse on or off and re-applies the pulse parameters
+ */
+void UNavPathGuideComponent::SetAnimatePulse(bool bNewAnimatePulse)
+{
+    bAnimatePulse = bNewAnimatePulse;
+    ApplyPulseParameters();
+}
+
+/**
+ * Sets the pulse speed and re-applies the pulse parameters
+ */
+void UNavPathGuideComponent::SetPulseSpeed(float NewPulseSpeed)
+{
+    PulseSpeed = FMath::Max(NewPulseSpeed, 0.0f);
+    ApplyPulseParameters();
+}
+
+/**
+ * Sets the path color
+ */
+void UNavPathGuideComponent::SetPathColor(const FLinearColor& NewColor)
 {
     PathColor = NewColor;
-    // Update all spline mesh dynamic materials
+    // The shared material drives both the pooled spline meshes and the ribbon
+    if (SharedDynMat)
+    {
+        SharedDynMat->SetVectorParameterValue(PathColorParameterName, PathColor);
+    }
+    // Update any spline mesh that carries a dynamic material of its own
     for (USplineMeshComponent* SplineMesh : SplineMeshes)
     {
-        if (SplineMesh)
+        if (SplineMesh)
+        {
+            UMaterialInstanceDynamic* DynMat = Cast<UMaterialInstanceDynamic>(SplineMesh->GetMaterial(0));
+            if (DynMat && DynMat != SharedDynMat)
+            {
+                DynMat->SetVectorParameterValue(PathColorParameterName, PathColor);
+            }
+        }
+    }
+    // Update Material Parameter Collection if set
+    if (PathMaterialParameterCollection)
+    {
+        UWorld* World = GetWorld();
+        if (World)
+        {
+            UMaterialParameterCollectionInstance* MPCInst = World->GetParameterCollectionInstance(PathMaterialParameterCollection);
+            if (MPCInst)
+            {
+                MPCInst->SetVectorParameterValue(PathColorParameterName, PathColor);
+            }
+        }
+    }
+}
+
+/**
+ * Updates the path if the player has moved more than the update threshold
+ */
+void UNavPathGuideComponent::UpdatePathIfNeeded()
+{
+    SCOPE_CYCLE_COUNTER(STAT_NavPathGuide_UpdatePathIfNeeded);
+    CSV_SCOPED_TIMING_STAT(NavPathGuide, UpdatePathIfNeeded);
+    
+    if (!GetOwner())
+    {
+        return;
+    }
+
+    // Check if player is on the navmesh
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    if (!NavSys)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("NavPathGuideComponent: No NavigationSystem found."));
+        return;
+    }
+
+    // Coalesce movement while an async query is in flight instead of superseding it every call
+    if (IsPathRequestPending())
+    {
+        return;
+    }
+
+    FVector OwnerLocation = GetOwner()->GetActorLocation();
+    FNavLocation NavLocation;
+    bool bOnNavmesh = LocateOnNavmesh(*NavSys, OwnerLocation, NavLocation);
+
+    if (!bOnNavmesh)
+    {
+        if (bHasActivePath)
+        {
+            UE_LOG(LogTemp, Log, TEXT("NavPathGuideComponent: Player left navmesh, clearing path."));
+            ClearPath();
+        }
+        return;
+    }
+    else
+    {
+        if (!bHasActivePath && PathDestination != FVector::ZeroVector)
+        {
+            UE_LOG(LogTemp, Log, TEXT("NavPathGuideComponent: Player returned to navmesh, attempting to regenerate path."));
+            // Try to regenerate the path
+            if (GeneratePathToLocation(PathDestination))
+            {
+                // The async modes have only submitted the request here; its outcome is logged on completion
+                if (IsPathRequestPending())
+                {
+                    bRebuildAfterNavmeshReturnPending = true;
+                }
+                else
+                {
+                    UE_LOG(LogTemp, Log, TEXT("NavPathGuideComponent: Path successfully rebuilt."));
+                }
+                // Update LastPlayerLocation so the path is not immediately cleared again
+                LastPlayerLocation = OwnerLocation;
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("NavPathGuideComponent: Failed to rebuild path after returning to navmesh."));
+            }
+        }
+    }
+
+    // Check if player has left the path corridor, or moved enough to warrant an update.
+    // The path lies on the ground, so distances to it are measured from the feet rather than the capsule centre
+    const FVector FeetLocation = GetOwnerFeetLocation();
+    bool bNeedsReplan = false;
+    if (bUseCorridorReplanning)
+    {
+        bNeedsReplan = bHasActivePath && HasLeftPathCorridor(FeetLocation, NavLocation.NodeRef);
+        if (bHasActivePath && !bNeedsReplan)
+        {
+            // Still on the path: just drop the segments already walked past
+            float DistanceSquared = 0.0f;
+            const int32 NearestSegment = FindNearestPathSegment(FeetLocation, CorridorRadius, DistanceSquared);
+            if (NearestSegment > 0)
+            {
+                TrimPassedSegments(NearestSegment);
+            }
+        }
+    }
+    else
+    {
+        float DistanceSquared = FVector::DistSquared(OwnerLocation, LastPlayerLocation);
+        bNeedsReplan = bHasActivePath && DistanceSquared > (UpdatePathThreshold * UpdatePathThreshold);
+    }
+    
+    if (bNeedsReplan)
+    {
+        // Prefer re-planning only the stretch near the player; fall back to a full rebuild
+        if (!bIncrementalPathUpdates || !SplicePathFromOwner())
+        {
+            GeneratePathToLocation(PathDestination);
+        }
+    }
+    else if (bHasActivePath)
+    {
+        // Extend detail along the path as the player advances
+        RefreshPathLOD(FeetLocation);
+    }
+}
+
+/**
+ * Owner location at the bottom of its collision, where it meets the ground the path is drawn on
+ */
+FVector UNavPathGuideComponent::GetOwnerFeetLocation() const
+{
+    const AActor* Owner = GetOwner();
+    return Owner ? Owner->GetActorLocation() - FVector(0, 0, Owner->GetSimpleCollisionHalfHeight()) : FVector::ZeroVector;
+}
+
+/**
+ * Locates a point on the navmesh, trying the tracked polygon and its neighbors before a full projection
+ */
+bool UNavPathGuideComponent::LocateOnNavmesh(UNavigationSystemV1& NavSys, const FVector& Location, FNavLocation& OutNavLocation)
+{
+    static const FVector QueryExtent(50, 50, 200);
+    const ARecastNavMesh* NavMesh = Cast<ARecastNavMesh>(NavSys.GetDefaultNavDataInstance(FNavigationSystem::DontCreate));
+    
+    if (NavMesh && NavMesh == TrackedNavMesh.Get() && TrackedNavPoly != INVALID_NAVNODEREF)
+    {
+        FVector PolyPoint;
+        if (IsOverNavPoly(*NavMesh, TrackedNavPoly, Location, QueryExtent.Z, PolyPoint))
+        {
+            OutNavLocation = FNavLocation(PolyPoint, TrackedNavPoly);
+            return true;
+        }
+        // Walking on the mesh almost always moves the owner onto an adjacent polygon
+        for (const NavNodeRef Neighbor : TrackedNavPolyNeighbors)
+        {
+            if (IsOverNavPoly(*NavMesh, Neighbor, Location, QueryExtent.Z, PolyPoint))
+            {
+                OutNavLocation = FNavLocation(PolyPoint, Neighbor);
+                TrackNavPoly(*NavMesh, Neighbor);
+                return true;
+            }
+        }
+    }
+    
+    const bool bOnNavmesh = NavSys.ProjectPointToNavigation(Location, OutNavLocation, QueryExtent);
+    if (bOnNavmesh && NavMesh && OutNavLocation.HasNodeRef())
+    {
+        if (NavMesh != TrackedNavMesh.Get())
+        {
+            TrackedNavMesh = NavMesh;
+            TrackedNavPoly = INVALID_NAVNODEREF;
+        }
+        TrackNavPoly(*NavMesh, OutNavLocation.NodeRef);
+    }
+    else
+    {
+        TrackedNavPoly = INVALID_NAVNODEREF;
+        TrackedNavPolyNeighbors.Reset();
+    }
+    return bOnNavmesh;
+}
+
+/**
+ * Whether a point lies over a nav polygon, returning the matching point on it
+ */
+bool UNavPathGuideComponent::IsOverNavPoly(const ARecastNavMesh& NavMesh, NavNodeRef PolyRef, const FVector& Location, float MaxVerticalDistance, FVector& OutPoint) const
+{
+    // Stale refs (e.g. from a rebuilt tile) fail here and fall through to the full projection
+    if (!NavMesh.GetPolyVerts(PolyRef, NavPolyVerts) || NavPolyVerts.Num() < 3)
+    {
+        return false;
+    }
+    
+    // Nav polygons are convex, so a fan around the first vertex covers them
+    const FVector P(Location.X, Location.Y, 0.0f);
+    const FVector A(NavPolyVerts[0].X, NavPolyVerts[0].Y, 0.0f);
+    for (int32 i = 1; i < NavPolyVerts.Num() - 1; ++i)
+    {
+        const FVector B(NavPolyVerts[i].X, NavPolyVerts[i].Y, 0.0f);
+        const FVector C(NavPolyVerts[i + 1].X, NavPolyVerts[i + 1].Y, 0.0f);
+        if (FMath::Abs(FVector::CrossProduct(B - A, C - A).Z) < UE_KINDA_SMALL_NUMBER)
         {
-            UMaterialInstanceDynamic* DynMat = Cast<UMaterialInstanceDynamic>(SplineMesh->GetMaterial(0));
-            if (DynMat)
-            {
-                DynMat->SetVectorParameterValue(PathColorParameterName, PathColor);
-            }
+            continue; // Degenerate triangle
+        }
+        const FVector Weights = FMath::ComputeBaryCentric2D(P, A, B, C);
+        if (Weights.X < -UE_KINDA_SMALL_NUMBER || Weights.Y < -UE_KINDA_SMALL_NUMBER || Weights.Z < -UE_KINDA_SMALL_NUMBER)
+        {
+            continue;
+        }
+        const float PolyZ = Weights.X * NavPolyVerts[0].Z + Weights.Y * NavPolyVerts[i].Z + Weights.Z * NavPolyVerts[i + 1].Z;
+        if (FMath::Abs(Location.Z - PolyZ) > MaxVerticalDistance)
+        {
+            return false;
         }
+        OutPoint = FVector(Location.X, Location.Y, PolyZ);
+        return true;
     }
-    // Update Material Parameter Collection if set
-    if (PathMaterialParameterCollection)
+    return false;
+}
+
+/**
+ * Tracks a nav polygon and caches its neighbors
+ */
+void UNavPathGuideComponent::TrackNavPoly(const ARecastNavMesh& NavMesh, NavNodeRef PolyRef)
+{
+    if (PolyRef == TrackedNavPoly)
     {
-        UWorld* World = GetWorld();
-        if (World)
+        return;
+    }
+    TrackedNavPoly = PolyRef;
+    TrackedNavPolyNeighbors.Reset();
+    NavMesh.GetPolyNeighbors(PolyRef, TrackedNavPolyNeighbors);
+}
+
+/**
+ * Finds the path segment closest to a location, looking only at grid cells within MaxDistance
+ */
+int32 UNavPathGuideComponent::FindNearestPathSegment(const FVector& Location, float MaxDistance, float& OutDistanceSquared) const
+{
+    int32 NearestSegment = INDEX_NONE;
+    OutDistanceSquared = FMath::Square(MaxDistance);
+    
+    auto TestSegment = [this, &Location, &NearestSegment, &OutDistanceSquared](int32 SegmentIndex)
+    {
+        const FVector Closest = FMath::ClosestPointOnSegment(Location, PathPoints[SegmentIndex], PathPoints[SegmentIndex + 1]);
+        const float DistSq = FVector::DistSquared(Location, Closest);
+        if (DistSq <= OutDistanceSquared)
         {
-            UMaterialParameterCollectionInstance* MPCInst = World->GetParameterCollectionInstance(PathMaterialParameterCollection);
-            if (MPCInst)
+            OutDistanceSquared = DistSq;
+            NearestSegment = SegmentIndex;
+        }
+    };
+    
+    const int32 MinX = FMath::FloorToInt32((Location.X - MaxDistance) / CorridorCellSize);
+    const int32 MaxX = FMath::FloorToInt32((Location.X + MaxDistance) / CorridorCellSize);
+    const int32 MinY = FMath::FloorToInt32((Location.Y - MaxDistance) / CorridorCellSize);
+    const int32 MaxY = FMath::FloorToInt32((Location.Y + MaxDistance) / CorridorCellSize);
+    const int64 NumCells = int64(MaxX - MinX + 1) * int64(MaxY - MinY + 1);
+    
+    // A search area bigger than the path itself is cheaper as a straight scan
+    if (CorridorGrid.Num() == 0 || NumCells > PathPoints.Num())
+    {
+        for (int32 i = 0; i < PathPoints.Num() - 1; ++i)
+        {
+            TestSegment(i);
+        }
+        return NearestSegment;
+    }
+    
+    for (int32 X = MinX; X <= MaxX; ++X)
+    {
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            if (const TArray<int32>* Segments = CorridorGrid.Find(FIntPoint(X, Y)))
             {
-                MPCInst->SetVectorParameterValue(PathColorParameterName, PathColor);
+                for (const int32 SegmentIndex : *Segments)
+                {
+                    TestSegment(SegmentIndex);
+                }
             }
         }
     }
+    return NearestSegment;
 }
 
 /**
- * Updates the path if the player has moved more than the update threshold
+ * Replaces the stretch of path between the player and a rejoin point further along, keeping the tail
  */
-void UNavPathGuideComponent::UpdatePathIfNeeded()
+bool UNavPathGuideComponent::SplicePathFromOwner()
 {
-    if (!GetOwner())
+    if (!GetOwner() || !PathSpline || PathPoints.Num() < 2)
     {
-        return;
+        return false;
+    }
+    
+    const FVector OwnerLocation = GetOwner()->GetActorLocation();
+    float DistanceSquared = 0.0f;
+    const int32 NearestSegment = FindNearestPathSegment(GetOwnerFeetLocation(), IncrementalMaxDeviation, DistanceSquared);
+    if (NearestSegment == INDEX_NONE)
+    {
+        return false; // Too far off the old path for its tail to still be the right route
+    }
+    
+    // Rejoin a few segments ahead; near the end a full rebuild costs about the same
+    const int32 RejoinIndex = NearestSegment + FMath::Max(IncrementalRejoinSegments, 1);
+    if (RejoinIndex >= PathPoints.Num() - 1)
+    {
+        return false;
+    }
+    const FVector RejoinPoint = PathPoints[RejoinIndex];
+    
+    PendingSpliceStart = OwnerLocation;
+    PendingSpliceRejoinPoint = RejoinPoint;
+    PendingSpliceCorridorPolys.Reset();
+    
+    // A clear navmesh line needs no pathfinding at all; otherwise plan just the short prefix
+    if (!RaycastSplicePrefix(OwnerLocation, RejoinPoint))
+    {
+        return BuildSplicePrefix(nullptr);
+    }
+    
+    if (bUseAsyncPathfinding)
+    {
+        // The old path stays up until the prefix arrives; a failed splice falls back to a full rebuild then
+        UNavigationSystemV1* NavSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+        return NavSystem && RequestAsyncPath(*NavSystem, OwnerLocation, RejoinPoint,
+            FNavPathQueryDelegate::CreateUObject(this, &UNavPathGuideComponent::OnAsyncSpliceFound));
     }
+    
+    UNavigationPath* PrefixPath = UNavigationSystemV1::FindPathToLocationSynchronously(GetWorld(), OwnerLocation, RejoinPoint, GetOwner(), NavigationFilterClass);
+    if (!PrefixPath || !PrefixPath->IsValid() || PrefixPath->PathPoints.Num() < 2)
+    {
+        return false;
+    }
+    return BuildSplicePrefix(PrefixPath);
+}
 
-    // Check if player is on the navmesh
+/**
+ * Casts a navmesh ray along a straight splice prefix, recording the polygons it crosses
+ */
+bool UNavPathGuideComponent::RaycastSplicePrefix(const FVector& Start, const FVector& End)
+{
     UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
-    if (!NavSys)
+    const ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : nullptr;
+    if (!NavMesh)
+    {
+        FVector RaycastHit;
+        return UNavigationSystemV1::NavigationRaycast(this, Start, End, RaycastHit);
+    }
+    
+    FRaycastResult RaycastResult;
+    FVector RaycastHit;
+    const bool bHit = ARecastNavMesh::NavMeshRaycast(NavMesh, INVALID_NAVNODEREF, Start, End, RaycastHit,
+        UNavigationQueryFilter::GetQueryFilter(*NavMesh, GetOwner(), NavigationFilterClass), GetOwner(), RaycastResult);
+    if (!bHit)
+    {
+        // A straight prefix has no path corridor of its own; without these the owner would leave the corridor polys at once
+        PendingSpliceCorridorPolys.Append(RaycastResult.CorridorPolys, RaycastResult.CorridorPolysCount);
+    }
+    return bHit;
+}
+
+/**
+ * Receives the async prefix query of a splice
+ */
+void UNavPathGuideComponent::OnAsyncSpliceFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr NavPath)
+{
+    if (QueryId != PendingPathQueryId)
     {
-        UE_LOG(LogTemp, Warning, TEXT("NavPathGuideComponent: No NavigationSystem found."));
         return;
     }
+    PendingPathQueryId = INVALID_NAVQUERYID;
+    
+    UNavigationPath* PrefixPath = nullptr;
+    if (Result == ENavigationQueryResult::Success && NavPath.IsValid())
+    {
+        PrefixPath = NewObject<UNavigationPath>(this);
+        PrefixPath->SetPath(NavPath);
+    }
+    if (!PrefixPath || !PrefixPath->IsValid() || PrefixPath->PathPoints.Num() < 2 || !BuildSplicePrefix(PrefixPath))
+    {
+        GeneratePathToLocation(PathDestination);
+    }
+}
 
-    FVector OwnerLocation = GetOwner()->GetActorLocation();
-    FNavLocation NavLocation;
-    bool bOnNavmesh = NavSys->ProjectPointToNavigation(OwnerLocation, NavLocation, FVector(50, 50, 200));
+/**
+ * Subdivides and ground-projects the prefix from the splice start to the rejoin point, then splices it in
+ */
+bool UNavPathGuideComponent::BuildSplicePrefix(UNavigationPath* PrefixPath)
+{
+    PendingSpliceCorners.Reset();
+    PendingSpliceCorners.Add(PendingSpliceStart);
+    if (PrefixPath)
+    {
+        for (int32 i = 1; i < PrefixPath->PathPoints.Num() - 1; ++i)
+        {
+            if (FVector::Dist(PrefixPath->PathPoints[i], PendingSpliceCorners.Last()) > 1.0f)
+            {
+                PendingSpliceCorners.Add(PrefixPath->PathPoints[i]);
+            }
+        }
+    }
+    PendingSpliceCorners.Add(PendingSpliceRejoinPoint);
+    
+    // The rejoin point itself is kept from the old path
+    TArray<FVector> PrefixSubdivided;
+    SubdividePolyline(PendingSpliceCorners, PrefixSubdivided);
+    PrefixSubdivided.Pop();
+    if (PrefixSubdivided.Num() == 0)
+    {
+        return false;
+    }
+    
+    if (bAsyncGroundProjection)
+    {
+        TArray<FVector> MissPoints;
+        ResolveCachedGroundHeights(PrefixSubdivided, MissPoints);
+        if (MissPoints.Num() > 0)
+        {
+            PendingNavPath = PrefixPath;
+            PendingGroundPoints = MoveTemp(PrefixSubdivided);
+            return SubmitGroundProjection(MissPoints,
+                FOnGroundProjectionComplete::CreateUObject(this, &UNavPathGuideComponent::OnSpliceGroundProjectionComplete));
+        }
+    }
+    else
+    {
+        for (FVector& Point : PrefixSubdivided)
+        {
+            Point = ProjectPointToGround(Point, TraceDistance, PathHeightOffset);
+        }
+    }
+    return CommitSplice(PrefixPath, PrefixSubdivided);
+}
 
-    if (!bOnNavmesh)
+/**
+ * Receives the ground heights of a splice prefix
+ */
+void UNavPathGuideComponent::OnSpliceGroundProjectionComplete(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask)
+{
+    UNavigationPath* PrefixPath = PendingNavPath;
+    PendingNavPath = nullptr;
+    if (!CommitSplice(PrefixPath, MergeGroundProjection(ProjectedPoints, HitMask)))
     {
-        if (bHasActivePath)
+        GeneratePathToLocation(PathDestination);
+    }
+}
+
+/**
+ * Replaces the path up to the rejoin point with the ground-projected prefix and updates only the affected visuals
+ */
+bool UNavPathGuideComponent::CommitSplice(UNavigationPath* PrefixPath, const TArray<FVector>& GroundPoints)
+{
+    // Nothing else edits the path while a splice is in flight, so the rejoin point is still where it was
+    const int32 RejoinIndex = PathPoints.IndexOfByKey(PendingSpliceRejoinPoint);
+    if (RejoinIndex == INDEX_NONE || !PathSpline)
+    {
+        return false;
+    }
+    
+    TArray<FVector> PrefixPoints;
+    PrefixPoints.Reserve(GroundPoints.Num());
+    for (const FVector& GroundPoint : GroundPoints)
+    {
+        if (PrefixPoints.Num() == 0 || FVector::Dist(GroundPoint, PrefixPoints.Last()) > 1.0f)
         {
-            UE_LOG(LogTemp, Log, TEXT("NavPathGuideComponent: Player left navmesh, clearing path."));
-            ClearPath();
+            PrefixPoints.Add(GroundPoint);
         }
+    }
+    if (PrefixPoints.Num() > 0 && FVector::Dist(PrefixPoints.Last(), PendingSpliceRejoinPoint) <= 1.0f)
+    {
+        PrefixPoints.Pop();
+    }
+    if (PrefixPoints.Num() == 0)
+    {
+        return false;
+    }
+    
+    const int32 NumRemoved = RejoinIndex;
+    const int32 NumAdded = PrefixPoints.Num();
+    const int32 OldNumSegments = PathPoints.Num() - 1;
+    
+    // Splice the world-space point list and the spline, reparameterizing the spline once
+    PathPoints.RemoveAt(0, NumRemoved, EAllowShrinking::No);
+    PathPoints.Insert(PrefixPoints, 0);
+    RebuildSplineFromPathPoints();
+    SpliceCurrentPath(PendingSpliceCorners);
+    LastPlayerLocation = PendingSpliceStart;
+    RebuildPathCorridor();
+    AddCorridorPolys(PrefixPath);
+    CorridorPolys.Append(PendingSpliceCorridorPolys);
+    PendingSpliceCorners.Reset();
+    PendingSpliceCorridorPolys.Reset();
+    
+    // Movement while the splice was in flight was coalesced into it
+    if (bAutoUpdatePath && (bUseAsyncPathfinding || bAsyncGroundProjection))
+    {
+        ScheduleAutomaticUpdate();
+    }
+    
+    if (!bShowNavGuide)
+    {
+        return true;
+    }
+    
+    if (PathVisualType == EPathVisualType::Ribbon || ActiveSplineMeshCount != OldNumSegments || IsVisualRebuildPending())
+    {
+        // The ribbon is a single primitive anyway, and meshes out of step with the old spline can't be shifted.
+        // Neither can a half-finished time-sliced rebuild, whose queue refers to the old segment indices
+        UpdatePathVisuals();
+        return true;
+    }
+    
+    ShiftSplineMeshes(NumRemoved, NumAdded);
+    
+    // Rebuild the new head plus the first tail segment, whose start tangent changed
+    BuildSegmentBuffer(0, NumAdded);
+    for (int32 SegmentIndex = 0; SegmentIndex <= NumAdded && SegmentIndex < ActiveSplineMeshCount; ++SegmentIndex)
+    {
+        UpdateSegmentVisual(SegmentIndex);
+    }
+    ReleaseUnusedSplineMeshes();
+    RefreshPathLOD(GetOwnerFeetLocation());
+    return true;
+}
+
+/**
+ * Replaces the corners of CurrentPath before the rejoin point with the corners of the splice prefix
+ */
+void UNavPathGuideComponent::SpliceCurrentPath(const TArray<FVector>& PrefixCorners)
+{
+    if (!CurrentPath || PrefixCorners.Num() < 2)
+    {
         return;
     }
-    else
+    
+    // The rejoin point lies on the old corner polyline; keep every corner after the segment it is on
+    const TArray<FVector>& OldCorners = CurrentPath->PathPoints;
+    const FVector& RejoinPoint = PrefixCorners.Last();
+    int32 RejoinSegment = INDEX_NONE;
+    float BestDistanceSquared = UE_MAX_FLT;
+    for (int32 i = 0; i < OldCorners.Num() - 1; ++i)
     {
-        if (!bHasActivePath && PathDestination != FVector::ZeroVector)
+        const float DistanceSquared = FMath::PointDistToSegmentSquared(RejoinPoint, OldCorners[i], OldCorners[i + 1]);
+        if (DistanceSquared < BestDistanceSquared)
         {
-            UE_LOG(LogTemp, Log, TEXT("NavPathGuideComponent: Player returned to navmesh, attempting to regenerate path."));
-            // Try to regenerate the path
-            if (GeneratePathToLocation(PathDestination))
-            {
-                UE_LOG(LogTemp, Log, TEXT("NavPathGuideComponent: Path successfully rebuilt."));
-                // Update LastPlayerLocation so the path is not immediately cleared again
-                LastPlayerLocation = OwnerLocation;
-            }
-            else
+            BestDistanceSquared = DistanceSquared;
+            RejoinSegment = i;
+        }
+    }
+    
+    TArray<FVector> Corners = PrefixCorners;
+    for (int32 i = RejoinSegment + 1; RejoinSegment != INDEX_NONE && i < OldCorners.Num(); ++i)
+    {
+        if (FVector::Dist(OldCorners[i], Corners.Last()) > 1.0f)
+        {
+            Corners.Add(OldCorners[i]);
+        }
+    }
+    
+    UNavigationPath* SplicedPath = NewObject<UNavigationPath>(this);
+    SplicedPath->SetPath(MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Corners, GetOwner()));
+    CurrentPath = SplicedPath;
+}
+
+/**
+ * Drops the meshes of the first NumRemoved segments and opens NumAdded head slots, keeping tail meshes on their segments
+ */
+void UNavPathGuideComponent::ShiftSplineMeshes(int32 NumRemoved, int32 NumAdded)
+{
+    // The replaced head meshes go back to the pool
+    const int32 NumTailSegments = FMath::Max(ActiveSplineMeshCount - NumRemoved, 0);
+    TArray<TObjectPtr<USplineMeshComponent>> SplicedMeshes;
+    SplicedMeshes.Reserve(SplineMeshes.Num() + NumAdded);
+    SplicedMeshes.AddDefaulted(NumAdded);
+    for (int32 i = 0; i < NumTailSegments; ++i)
+    {
+        SplicedMeshes.Add(SplineMeshes[NumRemoved + i]);
+    }
+    for (int32 i = 0; i < FMath::Min(NumRemoved, SplineMeshes.Num()); ++i)
+    {
+        // Reuse the replaced head meshes for the new head segments first
+        if (i < NumAdded)
+        {
+            SplicedMeshes[i] = SplineMeshes[i];
+        }
+        else
+        {
+            SplicedMeshes.Add(SplineMeshes[i]);
+        }
+    }
+    for (int32 i = NumRemoved + NumTailSegments; i < SplineMeshes.Num(); ++i)
+    {
+        SplicedMeshes.Add(SplineMeshes[i]);
+    }
+    // Head slots still empty take idle meshes from the pool before any new ones get created
+    for (int32 i = 0; i < NumAdded && SplicedMeshes.Num() > NumAdded + NumTailSegments; ++i)
+    {
+        if (!SplicedMeshes[i])
+        {
+            SplicedMeshes[i] = SplicedMeshes.Pop(EAllowShrinking::No);
+        }
+    }
+    SplineMeshes = MoveTemp(SplicedMeshes);
+    ActiveSplineMeshCount = NumAdded + NumTailSegments;
+    
+    // Tail slots keep their LOD; the new head slots still have to be built
+    TArray<ENavPathSegmentLOD> ShiftedLODs;
+    ShiftedLODs.SetNumZeroed(NumAdded);
+    for (int32 i = 0; i < NumTailSegments; ++i)
+    {
+        ShiftedLODs.Add(SegmentLODs.IsValidIndex(NumRemoved + i) ? SegmentLODs[NumRemoved + i] : ENavPathSegmentLOD::Unbuilt);
+    }
+    SegmentLODs = MoveTemp(ShiftedLODs);
+    SegmentBuffer.Shift(NumRemoved, NumAdded);
+}
+
+/**
+ * Drops the segments the player has already walked past
+ */
+void UNavPathGuideComponent::TrimPassedSegments(int32 NumPassed)
+{
+    if (!PathSpline || NumPassed <= 0 || NumPassed >= PathPoints.Num() - 1)
+    {
+        return;
+    }
+    
+    const int32 OldNumSegments = PathPoints.Num() - 1;
+    PathPoints.RemoveAt(0, NumPassed, EAllowShrinking::No);
+    RebuildSplineFromPathPoints();
+    RebuildPathCorridor();
+    
+    if (!bShowNavGuide)
+    {
+        return;
+    }
+    if (PathVisualType == EPathVisualType::Ribbon || ActiveSplineMeshCount != OldNumSegments || IsVisualRebuildPending())
+    {
+        UpdatePathVisuals();
+        return;
+    }
+    
+    ShiftSplineMeshes(NumPassed, 0);
+    // The new first segment lost its predecessor, so its start tangent changed
+    BuildSegmentBuffer(0, 0);
+    UpdateSegmentVisual(0);
+    ReleaseUnusedSplineMeshes();
+}
+
+/**
+ * Rebuilds the segment grid used for nearest-segment lookups
+ */
+void UNavPathGuideComponent::RebuildPathCorridor()
+{
+    CorridorGrid.Reset();
+    CorridorCellSize = FMath::Max(CorridorRadius, 50.0f);
+    PathBounds = FBox(PathPoints).ExpandBy(CorridorRadius);
+    for (int32 i = 0; i < PathPoints.Num() - 1; ++i)
+    {
+        const FVector& Start = PathPoints[i];
+        const FVector& End = PathPoints[i + 1];
+        const int32 MinX = FMath::FloorToInt32(FMath::Min(Start.X, End.X) / CorridorCellSize);
+        const int32 MaxX = FMath::FloorToInt32(FMath::Max(Start.X, End.X) / CorridorCellSize);
+        const int32 MinY = FMath::FloorToInt32(FMath::Min(Start.Y, End.Y) / CorridorCellSize);
+        const int32 MaxY = FMath::FloorToInt32(FMath::Max(Start.Y, End.Y) / CorridorCellSize);
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            for (int32 Y = MinY; Y <= MaxY; ++Y)
             {
-                UE_LOG(LogTemp, Warning, TEXT("NavPathGuideComponent: Failed to rebuild path after returning to navmesh."));
+                CorridorGrid.FindOrAdd(FIntPoint(X, Y)).Add(i);
             }
         }
     }
+}
 
-    // Check if player has moved enough to warrant an update
-    float DistanceSquared = FVector::DistSquared(OwnerLocation, LastPlayerLocation);
-    if (bHasActivePath && DistanceSquared > (UpdatePathThreshold * UpdatePathThreshold))
+/**
+ * Records the nav polygons a navigation path runs through as part of the corridor
+ */
+void UNavPathGuideComponent::AddCorridorPolys(UNavigationPath* NavPath)
+{
+    if (!NavPath || !NavPath->GetPath().IsValid())
     {
-        GeneratePathToLocation(PathDestination);
+        return;
+    }
+    if (const FNavMeshPath* NavMeshPath = NavPath->GetPath()->CastPath<FNavMeshPath>())
+    {
+        CorridorPolys.Append(NavMeshPath->PathCorridor);
+    }
+}
+
+/**
+ * Whether the player has left the corridor around the current path
+ */
+bool UNavPathGuideComponent::HasLeftPathCorridor(const FVector& Location, NavNodeRef NavPoly)
+{
+    float DistanceSquared = 0.0f;
+    if (FindNearestPathSegment(Location, CorridorRadius, DistanceSquared) == INDEX_NONE)
+    {
+        return true;
     }
+    
+    // Only a change of polygon can take the player off the path's polygons
+    if (NavPoly != INVALID_NAVNODEREF && NavPoly != LastCorridorPoly)
+    {
+        LastCorridorPoly = NavPoly;
+        if (CorridorPolys.Num() > 0 && !CorridorPolys.Contains(NavPoly))
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
@@ -609,19 +2874,12 @@ void UNavPathGuideComponent::EnableAutomaticUpdates(bool bEnable)
         return;
     }
     
-    // Clear any existing timer
+    // Clear any scheduled update
     World->GetTimerManager().ClearTimer(UpdatePathTimerHandle);
     
-    // Create new timer if enabled
+    // Check once right away; after that, movement and navmesh events schedule the updates
     if (bAutoUpdatePath && bHasActivePath)
     {
-        // Set timer to call UpdatePathIfNeeded as fast as possible (every tick)
-        World->GetTimerManager().SetTimer(
-            UpdatePathTimerHandle,
-            this,
-            &UNavPathGuideComponent::UpdatePathIfNeeded,
-            UpdateInterval, // Use property for interval
-            true // Loop
-        );
+        ScheduleAutomaticUpdate();
     }
 }
\ No newline at end of file
@@ -6,9 +6,26 @@
 #include "Components/SplineComponent.h"
 #include "NavigationSystem.h"
 #include "NavigationPath.h"
+#include "NavPathGroundProjector.h"
+#include "NavPathGroundHeightCache.h"
+#include "NavPathRouteCache.h"
+#include "NavPathSegmentBuffer.h"
+#include "Engine/StreamableManager.h"
+#include "ProceduralMeshComponent.h"
+#include "../WellnessBlock.h"
 #include "NavPathGuideComponent.generated.h"
 
 class AEscapeCharacter;
+class ANavigationData;
+class ARecastNavMesh;
+class UNavigationQueryFilter;
+class UWellnessRouteTableSubsystem;
+
+/** Broadcast whenever a path request finishes, synchronously or asynchronously. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNavPathGuideUpdated, bool, bPathFound);
+
+/** Broadcast once the soft-referenced path meshes and material have finished loading. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnNavPathGuideAssetsReady);
 
 /**
  * Enum defining different types of path visualization styles.
@@ -18,7 +35,20 @@ enum class EPathVisualType : uint8
 {
     Simple      UMETA(DisplayName = "Simple Line"),
     Detailed    UMETA(DisplayName = "Detailed Arrow"),
-    Animated    UMETA(DisplayName = "Animated Pulse")
+    Animated    UMETA(DisplayName = "Animated Pulse"),  // Simple line with the pulse on; see bAnimatePulse for other styles
+    Ribbon      UMETA(DisplayName = "Ribbon (Single Draw)")
+};
+
+/**
+ * Detail level a path segment's mesh slot was last built at.
+ */
+enum class ENavPathSegmentLOD : uint8
+{
+    Unbuilt,    // Not built since the slot was (re)assigned
+    Full,       // Own mesh, endpoints traced, custom depth
+    Coarse,     // One untraced mesh spanning a group of segments
+    Merged,     // Drawn by the Coarse mesh of its group
+    Hidden      // Beyond LODCoarseDistance
 };
 
 /**
@@ -38,19 +68,58 @@ public:
 
     /**
      *  Generate a path to the specified world location using the nav mesh.
+     *  In async mode the query runs off the game thread and the current path stays visible until the result arrives.
      *  @param Destination The world location to navigate to
-     *  @return True if a valid path was found
+     *  @return True if a valid path was found (async mode: true if the query was submitted)
      */
     UFUNCTION(BlueprintCallable, Category = "Navigation|Path")
     bool GeneratePathToLocation(const FVector& Destination);
 
     /**
      *  Generate a path to the specified actor using the nav mesh.
+     *  Routes between wellness blocks are taken from the precomputed route table when available.
      *  @param TargetActor The actor to navigate to
      *  @return True if a valid path was found
      */
     UFUNCTION(BlueprintCallable, Category = "Navigation|Path")
     bool GeneratePathToActor(AActor* TargetActor);
+
+    /**
+     *  Generate a path to the closest wellness block of a type, looked up in the block registry.
+     *  @param BlockType The kind of block to navigate to
+     *  @return True if a block was found and a valid path to it was found
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Path")
+    bool GeneratePathToNearestBlockOfType(EWellnessBlockType BlockType);
+
+    /**
+     *  Plans a visiting order for several targets and draws the path to the first one.
+     *  The order minimises total travel using navmesh route lengths where the route table has them
+     *  (straight-line distance otherwise), with a nearest-neighbour tour improved by 2-opt.
+     *  @param Targets The actors to visit, e.g. the blocks left in the daily goal
+     *  @return True if a path to the first stop was found
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Multi-Stop")
+    bool PlanMultiStopRoute(const TArray<AActor*>& Targets);
+
+    /**
+     *  Moves on to the next stop of the planned route and draws the path to it.
+     *  @return True if there was a next stop and a path to it was found
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Multi-Stop")
+    bool AdvanceMultiStopRoute();
+
+    /**  Forgets the planned route. The current path stays until cleared. */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Multi-Stop")
+    void ClearMultiStopRoute();
+
+    /**  The planned stops in visiting order. Stops whose actor was destroyed are skipped. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Multi-Stop")
+    TArray<AActor*> GetMultiStopOrder() const;
+
+    /**  Index of the stop currently being guided to, or INDEX_NONE without a planned route. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Multi-Stop")
+    int32 GetCurrentStopIndex() const { return MultiStops.IsValidIndex(CurrentStopIndex) ? CurrentStopIndex : INDEX_NONE; }
     
     /**
      *  Updates the visual representation of the path with spline meshes.
@@ -85,6 +154,33 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Navigation|Visuals")
     void SetPathColor(const FLinearColor& NewColor);
     
+    /**
+     *  Turns the pulse on or off for any visual style, including Ribbon, and pushes it to the material right away.
+     *  @param bNewAnimatePulse Whether the path pulses towards the destination
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Visuals|Animation")
+    void SetAnimatePulse(bool bNewAnimatePulse);
+    
+    /**
+     *  Whether the path pulse is on, either through bAnimatePulse or the Animated visual style.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Visuals|Animation")
+    bool IsPulseAnimated() const { return bAnimatePulse || PathVisualType == EPathVisualType::Animated; }
+    
+    /**
+     *  Sets the speed of the pulse and pushes it to the material right away.
+     *  @param NewPulseSpeed Speed in cm/s at which pulses travel towards the destination
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Visuals|Animation")
+    void SetPulseSpeed(float NewPulseSpeed);
+    
+    /**
+     *  Gets the speed of the pulse.
+     *  @return Speed in cm/s at which pulses travel towards the destination
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Visuals|Animation")
+    float GetPulseSpeed() const { return PulseSpeed; }
+    
     /**
      *  Gets the current path color.
      *  @return The current color of the path visuals
@@ -93,14 +189,15 @@ public:
     FLinearColor GetPathColor() const { return PathColor; }
 
     /**
-     *  Updates the path if the player has moved more than the update threshold.
-     *  Called manually or on a timer.
+     *  Updates the path if the player has left the path corridor or moved more than the update threshold.
+     *  Called manually or by the automatic update scheduler.
      */
     UFUNCTION(BlueprintCallable, Category = "Navigation|Path")
     void UpdatePathIfNeeded();
 
     /**
-     *  Enables automatic path updates on a timer.
+     *  Enables automatic path updates. Updates are scheduled when the owner moves or the navmesh
+     *  under the path is rebuilt, at most once per UpdateInterval; nothing runs while the owner stands still.
      *  @param bEnable Whether to enable automatic updates
      */
     UFUNCTION(BlueprintCallable, Category = "Navigation|Path")
@@ -133,7 +230,151 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Path")
     bool bShowNavGuide = true;
 
+    /**
+     *  Whether path queries use the navigation system's async pathfinding instead of blocking the game thread.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Path")
+    bool bUseAsyncPathfinding = false;
+
+    /**
+     *  Whether ground heights for subdivided path points are resolved with one batch of async traces
+     *  instead of synchronous traces. The path appears once the batch completes.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Path")
+    bool bAsyncGroundProjection = false;
+
+    /**
+     *  Whether ground heights are cached per XY cell so repeated rebuilds over the same ground skip the traces.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Ground Cache")
+    bool bUseGroundHeightCache = true;
+
+    /**
+     *  Size in cm of one ground cache cell. Smaller cells follow slopes more closely but hit less often.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Navigation|Ground Cache", meta = (ClampMin = "1", UIMin = "1"))
+    float GroundCacheCellSize = 25.0f;
+
+    /**
+     *  Seconds a cached ground height stays valid (0 = until invalidated).
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Navigation|Ground Cache", meta = (ClampMin = "0", UIMin = "0"))
+    float GroundCacheLifetime = 30.0f;
+
+    /**
+     *  Largest height difference in cm, on top of the path height offset, between a point and a cached ground height
+     *  for the cache to be used. Keeps stacked floors and ledges in the same cell from borrowing each other's ground.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Ground Cache", meta = (ClampMin = "0", UIMin = "0"))
+    float GroundCacheMaxStepHeight = 50.0f;
+
+    /**
+     *  Changes the ground cache cell size. Drops all cached heights.
+     *  @param NewCellSize The new cell size in cm
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Ground Cache")
+    void SetGroundCacheCellSize(float NewCellSize);
+
+    /**
+     *  Drops cached ground heights inside the given box, e.g. after moving geometry.
+     *  @param Bounds The world-space area to invalidate
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Ground Cache")
+    void InvalidateGroundCache(const FBox& Bounds);
+
+    /**  Number of ground projections served from the cache since the last reset. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Ground Cache")
+    int32 GetGroundCacheHitCount() const { return GroundHeightCache.GetHits(); }
+
+    /**  Number of ground projections that had to trace since the last reset. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Ground Cache")
+    int32 GetGroundCacheMissCount() const { return GroundHeightCache.GetMisses(); }
+
+    /**  Resets the ground cache hit and miss counters. */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Ground Cache")
+    void ResetGroundCacheStats();
+
+    /**  Number of ground line traces issued since the component was created, synchronous and async. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Ground Cache")
+    int32 GetGroundTraceCount() const;
+
+    /**
+     *  Whether an async path query or ground projection batch is currently in flight.
+     *  @return True if a result is still pending
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Path")
+    bool IsPathRequestPending() const { return PendingPathQueryId != INVALID_NAVQUERYID || (GroundProjector.IsValid() && GroundProjector->IsBusy()); }
+
+    /**
+     *  Called when a path request completes. Carries whether a valid path was found.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Navigation|Path")
+    FOnNavPathGuideUpdated OnPathUpdated;
+
+    /**
+     *  Starts loading PathMesh, ArrowMesh and PathMaterial if they are not in memory yet.
+     *  Path requests call this; calling it earlier (e.g. from a loading screen) hides the load entirely.
+     *  @return True if the assets are already loaded
+     */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Visuals")
+    bool RequestVisualAssets();
+
+    /**
+     *  Whether every assigned visual asset is in memory.
+     *  @return True once the path can be drawn
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Visuals")
+    bool AreVisualAssetsLoaded() const;
+
+    /**
+     *  Called once the visual assets have finished loading.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Navigation|Visuals")
+    FOnNavPathGuideAssetsReady OnVisualAssetsReady;
+
+    /**
+     *  Query filter used for path queries. Part of the route cache key.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Path")
+    TSubclassOf<UNavigationQueryFilter> NavigationFilterClass;
+
+    /**
+     *  Whether finished routes are cached by start polygon, destination polygon and filter,
+     *  so walking the same route again skips the path query and the ground traces.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Route Cache")
+    bool bUseRouteCache = false;
+
+    /**
+     *  Maximum number of cached routes. The least recently used route is evicted past this.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Navigation|Route Cache", meta = (ClampMin = "0", UIMin = "0"))
+    int32 RouteCacheCapacity = 16;
+
+    /**
+     *  Whether GeneratePathToActor uses the level's precomputed wellness block route table
+     *  when the owner stands at a block and the target is another block.
+     *  The table is skipped while a NavigationFilterClass is set, since its routes use the default filter.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation|Route Cache")
+    bool bUseRouteTable = true;
+
+    /**  Drops every cached route. */
+    UFUNCTION(BlueprintCallable, Category = "Navigation|Route Cache")
+    void InvalidateRouteCache();
+
+    /**  Number of path requests served from the route cache since the start of play. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Route Cache")
+    int32 GetRouteCacheHitCount() const { return RouteCache.GetHits(); }
+
+    /**  Number of path requests that missed the route cache since the start of play. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Route Cache")
+    int32 GetRouteCacheMissCount() const { return RouteCache.GetMisses(); }
+
 protected:
+    /** Runs routes through the guide for the NavPathGuide.Benchmark console command. */
+    friend struct FNavPathGuideBenchmark;
+
     /** Called when the game starts */
     virtual void BeginPlay() override;
     
@@ -152,11 +393,115 @@ private:
     TObjectPtr<USplineComponent> PathSpline;
     
     /**
-     *  Array of spline mesh components used to visualize the path.
-     *  Created and updated dynamically.
+     *  Pool of spline mesh components used to visualize the path.
+     *  The first ActiveSplineMeshCount entries are in use; the rest stay registered but hidden for reuse.
      */
     UPROPERTY(Transient)
     TArray<TObjectPtr<USplineMeshComponent>> SplineMeshes;
+
+    /**
+     *  Dynamic mesh that draws the whole path as one ribbon in EPathVisualType::Ribbon mode.
+     *  Created on first use.
+     */
+    UPROPERTY(Transient)
+    TObjectPtr<UProceduralMeshComponent> PathRibbon;
+
+    /**
+     *  Vertex buffers reused between ribbon rebuilds.
+     */
+    TArray<FVector> RibbonVertices;
+    TArray<FVector> RibbonNormals;
+    TArray<FVector2D> RibbonUVs;
+    TArray<FVector2D> RibbonDistanceUVs;
+    TArray<FProcMeshTangent> RibbonTangents;
+
+    /**
+     *  Vertex count of the ribbon's current mesh section. Matching counts are updated in place.
+     */
+    int32 RibbonSectionVertexCount = 0;
+
+    /**
+     *  Number of pooled spline meshes used by the current path.
+     */
+    int32 ActiveSplineMeshCount = 0;
+
+    /**
+     *  Spline mesh parameters of the active segments, computed ahead of applying them to the components.
+     */
+    FNavPathSegmentBuffer SegmentBuffer;
+
+    /**
+     *  Maximum number of spline meshes kept in the pool. Meshes past this are destroyed when released.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals", meta = (ClampMin = "0", UIMin = "0"))
+    int32 MaxPooledSplineMeshes = 256;
+
+    /**
+     *  Whether the path uses distance-based detail: full meshes near the owner, one untraced mesh per
+     *  LODCoarseStride segments further along the path, and nothing past LODCoarseDistance.
+     *  Detail extends along the path as the owner advances.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|LOD")
+    bool bUsePathLOD = false;
+
+    /**
+     *  Path distance from the owner within which segments are drawn at full detail.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|LOD", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bUsePathLOD"))
+    float LODFullDetailDistance = 2000.0f;
+
+    /**
+     *  Path distance from the owner beyond which segments are not drawn.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|LOD", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bUsePathLOD"))
+    float LODCoarseDistance = 6000.0f;
+
+    /**
+     *  Number of segments merged into one mesh between LODFullDetailDistance and LODCoarseDistance.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|LOD", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUsePathLOD"))
+    int32 LODCoarseStride = 4;
+
+    /**
+     *  Detail level each active mesh slot was last built at, and the remaining path distance at the owner
+     *  that LOD distances are measured from.
+     */
+    TArray<ENavPathSegmentLOD> SegmentLODs;
+    float LODOriginDistance = 0.0f;
+
+    /**
+     *  Whether spline mesh rebuilds are spread over several frames, nearest segments first,
+     *  instead of building every segment in the call that changed the path.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals")
+    bool bTimeSliceVisualRebuild = false;
+
+    /**
+     *  Game thread time in milliseconds a time-sliced rebuild may spend per frame. At least one segment is built per frame.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals", meta = (ClampMin = "0.01", UIMin = "0.01", EditCondition = "bTimeSliceVisualRebuild"))
+    float VisualRebuildBudgetMs = 1.0f;
+
+    /**
+     *  Segments still waiting to be built by a time-sliced rebuild, in build order. Consumed from VisualRebuildCursor.
+     */
+    TArray<int32> VisualRebuildQueue;
+    int32 VisualRebuildCursor = 0;
+    
+    /**
+     *  World-space, ground-projected points of the current path, one per spline point.
+     */
+    TArray<FVector> PathPoints;
+    
+    /**
+     *  World-space tangents at PathPoints, computed analytically when the spline is built.
+     */
+    TArray<FVector> PathTangents;
+    
+    /**
+     *  Path distance from each of PathPoints to the destination. Baked into the visuals for the animated pulse.
+     */
+    TArray<float> PathRemainingDistances;
     
     /**
      *  The current navigation path as calculated by the navigation system.
@@ -190,22 +535,33 @@ private:
     FLinearColor PathColor = FLinearColor(0.0f, 0.75f, 1.0f, 1.0f); // Light blue by default
     
     /**
-     *  The static mesh to use for the path visuals.
+     *  The static mesh to use for the path visuals. Loaded asynchronously on the first path request.
      */
     UPROPERTY(EditAnywhere, Category = "Navigation|Visuals")
-    TObjectPtr<UStaticMesh> PathMesh;
+    TSoftObjectPtr<UStaticMesh> PathMesh;
 
     /**
-     *  The static mesh to use for arrow segments in detailed path mode.
+     *  The static mesh to use for arrow segments in detailed path mode. Loaded with PathMesh.
      */
     UPROPERTY(EditAnywhere, Category = "Navigation|Visuals")
-    TObjectPtr<UStaticMesh> ArrowMesh;
+    TSoftObjectPtr<UStaticMesh> ArrowMesh;
     
     /**
-     *  The material to use for the path visuals.
+     *  The material to use for the path visuals. Loaded with PathMesh.
+     *  Must read the pulse parameters for the pulse to show; see PulseAmountParameterName.
      */
     UPROPERTY(EditAnywhere, Category = "Navigation|Visuals")
-    TObjectPtr<UMaterialInterface> PathMaterial;
+    TSoftObjectPtr<UMaterialInterface> PathMaterial;
+
+    /**
+     *  Keeps the loaded visual assets in memory while the component is alive.
+     */
+    TSharedPtr<FStreamableHandle> VisualAssetsHandle;
+
+    /**
+     *  Streamable manager callback for the visual assets. Draws any path that was found while they loaded.
+     */
+    void OnVisualAssetsLoaded();
     
     /**
      *  The width of the path visuals.
@@ -222,9 +578,72 @@ private:
     /**
      *  Distance threshold in cm that triggers a path update when the player moves.
      */
-    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (EditCondition = "bAutoUpdatePath"))
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (EditCondition = "bAutoUpdatePath && !bUseCorridorReplanning"))
     float UpdatePathThreshold = 0.0f;
+
+    /**
+     *  Whether the path is only re-planned when the player leaves the corridor around it or walks onto a nav polygon
+     *  the path does not cross, instead of whenever they move past UpdatePathThreshold.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path")
+    bool bUseCorridorReplanning = true;
+
+    /**
+     *  Half-width in cm of the corridor around the path that the player may move in without a re-plan.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bUseCorridorReplanning"))
+    float CorridorRadius = 150.0f;
     
+    /**
+     *  Whether player movement splices a re-planned head onto the still-valid tail of the path
+     *  instead of rebuilding the whole path.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path")
+    bool bIncrementalPathUpdates = false;
+
+    /**
+     *  How many segments past the player's nearest segment the re-planned head rejoins the old path.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bIncrementalPathUpdates"))
+    int32 IncrementalRejoinSegments = 3;
+
+    /**
+     *  Distance in cm from the old path beyond which a full rebuild is done instead of a splice.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bIncrementalPathUpdates"))
+    float IncrementalMaxDeviation = 300.0f;
+
+    /**
+     *  Whether navmesh corners that change the route by less than PathSimplifyTolerance are dropped before subdivision.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path")
+    bool bSimplifyPath = false;
+
+    /**
+     *  Error tolerance in cm for path simplification and for the ground check of adaptive subdivision.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (ClampMin = "0", UIMin = "0"))
+    float PathSimplifyTolerance = 10.0f;
+
+    /**
+     *  Whether straight, flat runs are subdivided into longer pieces (up to AdaptiveMaxSegmentLength),
+     *  keeping MaxSplineSegmentLength only next to sharp corners and over uneven ground.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path")
+    bool bAdaptiveSubdivision = false;
+
+    /**
+     *  Longest segment adaptive subdivision may produce on straight, flat ground.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (ClampMin = "1", UIMin = "1", EditCondition = "bAdaptiveSubdivision"))
+    float AdaptiveMaxSegmentLength = 400.0f;
+
+    /**
+     *  Turn angle in degrees above which a corner is treated as sharp by adaptive subdivision.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (ClampMin = "0", ClampMax = "180", UIMin = "0", UIMax = "180", EditCondition = "bAdaptiveSubdivision"))
+    float AdaptiveCornerAngle = 15.0f;
+
     /**
      *  Whether to automatically update the path as the player moves.
      */
@@ -232,15 +651,32 @@ private:
     bool bAutoUpdatePath = false;
     
     /**
-     *  Interval in seconds between automatic path updates.
+     *  Minimum interval in seconds between automatic path updates.
      */
     UPROPERTY(EditAnywhere, Category = "Navigation|Path", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bAutoUpdatePath"))
     float UpdateInterval = 0.5f;
     
     /**
-     *  Timer handle for automatic path updates.
+     *  Timer handle for the next scheduled automatic path update.
      */
     FTimerHandle UpdatePathTimerHandle;
+
+    /**
+     *  World time of the last automatic path update, used to throttle movement-driven updates.
+     */
+    double LastAutomaticUpdateTime = -1.0;
+
+    /**
+     *  Set when the navmesh under the current path was dirtied; the path is re-planned once the rebuild finishes.
+     *  Committing a result does not clear it, since that result may have been planned on the old navmesh;
+     *  only issuing the re-plan itself does.
+     */
+    bool bNavigationChangedOnPath = false;
+
+    /**
+     *  Bounds of the current path expanded by CorridorRadius, used to filter navmesh changes.
+     */
+    FBox PathBounds = FBox(ForceInit);
     
     /**
      *  Name of the color parameter in the material (default: "Color")
@@ -254,6 +690,50 @@ private:
     UPROPERTY(EditAnywhere, Category = "Navigation|Visuals")
     TObjectPtr<UMaterialParameterCollection> PathMaterialParameterCollection = nullptr;
 
+    /**
+     *  The pulse is evaluated entirely in the material. Every spline mesh carries the path distance
+     *  left to the destination at its start in custom primitive data 0 and its own length in custom primitive
+     *  data 1; the ribbon carries the distance left per vertex in UV channel 1 (X). The material combines
+     *  these with its Time node, PulseSpeed and PulseSpacing; PulseAmount is 1 while IsPulseAnimated() and 0 otherwise.
+     *  Distances count down towards the destination, so trimming or splicing the head of the path leaves the
+     *  baked values of the remaining segments valid.
+     *  The default BasicShapeMaterial reads none of these, so the pulse needs a custom PathMaterial that does,
+     *  e.g. emissive = PulseAmount * frac((CPD0 - Time * PulseSpeed) / PulseSpacing) with CPD0 offset by the
+     *  mesh's local distance along CPD1, or UV1.x for the ribbon. Without one, the path does not pulse.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|Animation")
+    FName PulseAmountParameterName = TEXT("PulseAmount");
+
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|Animation")
+    FName PulseSpeedParameterName = TEXT("PulseSpeed");
+
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|Animation")
+    FName PulseSpacingParameterName = TEXT("PulseSpacing");
+
+    /**
+     *  Pulses the path towards the destination with any visual style. Independent of the backend, so it also
+     *  works with Ribbon; the Animated style turns the pulse on for the spline meshes regardless of this flag.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|Animation")
+    bool bAnimatePulse = false;
+
+    /**
+     *  Speed in cm/s at which pulses travel towards the destination.
+     */
+    UPROPERTY(EditAnywhere, BlueprintGetter = GetPulseSpeed, BlueprintSetter = SetPulseSpeed, Category = "Navigation|Visuals|Animation", meta = (ClampMin = "0", UIMin = "0"))
+    float PulseSpeed = 300.0f;
+
+    /**
+     *  Distance in cm between two pulses.
+     */
+    UPROPERTY(EditAnywhere, Category = "Navigation|Visuals|Animation", meta = (ClampMin = "1", UIMin = "1"))
+    float PulseSpacing = 400.0f;
+
+    /**
+     *  Pushes the pulse parameters to the shared material and the parameter collection.
+     */
+    void ApplyPulseParameters();
+
     /**
      *  Shared dynamic material instance for all spline meshes
      */
@@ -265,11 +745,492 @@ private:
      */
     void EnsureSplineExists();
     
+    /**
+     *  Processes and subdivides a navigation path result and projects it to the ground.
+     *  With bAsyncGroundProjection the path is committed later, when the trace batch completes.
+     *  @param NavPath The path returned by the navigation system (may be null)
+     *  @return True if the path was valid and has been built or submitted for projection
+     */
+    bool BuildPathFromNavPath(UNavigationPath* NavPath);
+
+    /**
+     *  Reduces a polyline in place with Douglas-Peucker at PathSimplifyTolerance. End points are always kept.
+     */
+    void SimplifyPolyline(TArray<FVector>& Points) const;
+
+    /**
+     *  Subdivides a polyline into spline points - uniformly at MaxSplineSegmentLength, or adaptively
+     *  by corner sharpness and ground shape when bAdaptiveSubdivision is set. Points are not ground-projected.
+     *  @param Corners The polyline to subdivide
+     *  @param OutPoints Receives the subdivided points, including both ends
+     */
+    void SubdividePolyline(const TArray<FVector>& Corners, TArray<FVector>& OutPoints) const;
+
+    /**
+     *  Appends the end of a span to OutPoints, recursively halving it while it is too long or, if bProbeGround
+     *  is set, while the ground under its midpoint deviates from a straight line by more than PathSimplifyTolerance.
+     */
+    void AppendAdaptiveSpan(const FVector& Start, const FVector& End, bool bProbeGround, int32 Depth, TArray<FVector>& OutPoints) const;
+
+    /**
+     *  Replaces the current path with ground-projected points and rebuilds the visuals.
+     *  @param NavPath The navigation path the points came from
+     *  @param GroundPoints Subdivided points already projected to the ground
+     *  @param RouteCorridorPolys Nav polygons the points cross, for paths that do not come with a NavPath
+     */
+    void CommitPathPoints(UNavigationPath* NavPath, const TArray<FVector>& GroundPoints, TConstArrayView<NavNodeRef> RouteCorridorPolys = {});
+
+    /**
+     *  Completion callback of the async ground projection batch.
+     */
+    void OnGroundProjectionComplete(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask);
+
+    /**
+     *  Replaces points with cached ground heights where the cache has them.
+     *  The rest are collected for a trace batch and their indices recorded in PendingGroundMissIndices.
+     */
+    void ResolveCachedGroundHeights(TArray<FVector>& Points, TArray<FVector>& OutMissPoints);
+
+    /**
+     *  Submits points to the async ground projector, creating it on first use.
+     *  @return True if the batch was submitted
+     */
+    bool SubmitGroundProjection(const TArray<FVector>& MissPoints, FOnGroundProjectionComplete OnComplete);
+
+    /**
+     *  Writes the results of a finished trace batch into PendingGroundPoints, stores hits in the ground cache
+     *  and moves the merged points out.
+     */
+    TArray<FVector> MergeGroundProjection(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask);
+
+    /**
+     *  Invalidates cached ground heights in an area where navigation was dirtied by geometry changes.
+     */
+    void OnNavigationDirtied(const FBox& DirtyBounds);
+
+    /**
+     *  Removes the spline points and meshes of the current path without touching pending requests.
+     */
+    void ResetPathState();
+
+    /**
+     *  Drops the path query and ground projection batch in flight, if any.
+     */
+    void CancelPendingRequests();
+
+    /**
+     *  Submits an async path query, superseding any pending query.
+     *  @param NavSystem The navigation system to query
+     *  @param StartLocation The world location to path from
+     *  @param EndLocation The world location to path to
+     *  @param OnPathFound Called with the result unless the query is superseded first
+     *  @return True if the query was submitted
+     */
+    bool RequestAsyncPath(UNavigationSystemV1& NavSystem, const FVector& StartLocation, const FVector& EndLocation, FNavPathQueryDelegate OnPathFound);
+
+    /**
+     *  Callback for async path queries. Results from superseded queries are dropped.
+     */
+    void OnAsyncPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr NavPath);
+
+    /**
+     *  Aborts the async path query in flight, if any.
+     */
+    void CancelPendingPathQuery();
+
+    /**
+     *  Id of the async path query in flight, or INVALID_NAVQUERYID if none.
+     */
+    uint32 PendingPathQueryId = INVALID_NAVQUERYID;
+
+    /**
+     *  Set while the rebuild after returning to the navmesh is still in flight, so its outcome is logged once it lands.
+     */
+    bool bRebuildAfterNavmeshReturnPending = false;
+
+    /**
+     *  Batched async ground projection service. Created on first use.
+     */
+    TSharedPtr<FNavPathGroundProjector> GroundProjector;
+
+    /**
+     *  Synchronous ground traces issued by ProjectPointToGround. Also feeds the NavPathGuide stat group and CSV category.
+     */
+    mutable int32 SyncGroundTraceCount = 0;
+    void CountGroundTrace() const;
+
+    /**
+     *  Navigation path whose points are waiting on the ground projection batch.
+     */
+    UPROPERTY(Transient)
+    TObjectPtr<UNavigationPath> PendingNavPath;
+
+    /**
+     *  Subdivided points of the pending path, with cache hits already resolved.
+     */
+    TArray<FVector> PendingGroundPoints;
+
+    /**
+     *  Indices into PendingGroundPoints that were submitted to the trace batch, in submission order.
+     */
+    TArray<int32> PendingGroundMissIndices;
+
+    /**
+     *  Persistent XY-cell cache of ground impact heights. Mutable so const ground projection can fill it.
+     */
+    mutable FNavPathGroundHeightCache GroundHeightCache;
+
+    /**
+     *  Finished routes by start polygon, destination polygon and filter.
+     */
+    FNavPathRouteCache RouteCache;
+
+    /**
+     *  Key the request in flight will be cached under once it is committed. Invalid for uncached requests.
+     */
+    FNavPathRouteKey PendingRouteKey;
+
+    /**
+     *  Union of navmesh areas dirtied since the last finished rebuild. Routes through it are dropped once the rebuild is done.
+     */
+    FBox PendingNavDirtyBounds = FBox(ForceInit);
+
+    /**
+     *  Builds the route cache key for a path request.
+     *  @param NavSys The navigation system
+     *  @param Start The path start
+     *  @param Destination The path destination
+     *  @param OutKey The route key
+     *  @param OutNavDestination The destination projected onto the navmesh
+     *  @return True if both ends are on the navmesh
+     */
+    bool MakeRouteKey(UNavigationSystemV1& NavSys, const FVector& Start, const FVector& Destination, FNavPathRouteKey& OutKey, FVector& OutNavDestination);
+
+    /**
+     *  Stops of the planned multi-stop route in visiting order, and the stop currently guided to.
+     */
+    TArray<TWeakObjectPtr<AActor>> MultiStops;
+    int32 CurrentStopIndex = INDEX_NONE;
+
+    /**
+     *  Travel cost between two planning nodes.
+     *  @param RouteTable Route table to read precomputed route lengths from, or nullptr for straight-line distance
+     *  @param FromActor Start actor, or nullptr for the owner
+     *  @return The cost in cm, or -1 if the route table has no route for the pair
+     */
+    float GetTravelCost(const UWellnessRouteTableSubsystem* RouteTable, const AActor* FromActor, const AActor* ToActor) const;
+
+    /**
+     *  Orders the stops of an open tour starting at node 0 by nearest neighbour, then improves it with 2-opt.
+     *  @param Costs Row-major NumNodes x NumNodes symmetric cost matrix
+     *  @param NumNodes Number of nodes including the start
+     *  @return Node indices in visiting order, starting with 0
+     */
+    static TArray<int32> SolveVisitingOrder(const TArray<float>& Costs, int32 NumNodes);
+
+    /**  Draws the path to the current stop, skipping stops whose actor is gone. */
+    bool GuideToCurrentStop();
+
+    /**
+     *  The level's wellness block route table, if this guide may use it. Table routes are planned with the default
+     *  query filter on the default navigation data, so guides with a NavigationFilterClass or an agent that maps to
+     *  other navigation data get nullptr.
+     */
+    const UWellnessRouteTableSubsystem* GetUsableRouteTable() const;
+
+    /**
+     *  Commits a route taken from the wellness block route table.
+     *  @param Destination The target location
+     *  @param GroundPoints Ground points of the route, without height offset
+     *  @return False if the navmesh blocks the straight lead-in from the owner to the route, so a live query is needed
+     */
+    bool CommitTableRoute(const FVector& Destination, TArray<FVector>& GroundPoints);
+
+    /**
+     *  Commits a cached route, trimming the cached points behind the current start and past the current destination
+     *  and re-anchoring its ends on them. The route's corridor polygons are in place before OnPathUpdated fires.
+     */
+    void CommitCachedRoute(const FNavPathRouteEntry& Route, const FVector& Start, const FVector& NavDestination);
+
+    /**
+     *  Handle for the navigation dirty event binding.
+     */
+    FDelegateHandle NavigationDirtiedHandle;
+
+    /**
+     *  Root component whose movement wakes automatic updates, and the handle of that binding.
+     */
+    TWeakObjectPtr<USceneComponent> WatchedRootComponent;
+    FDelegateHandle OwnerTransformUpdatedHandle;
+
+    /**
+     *  Called whenever the owner's root component moves. Schedules a throttled automatic update.
+     */
+    void OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+    /**
+     *  Called when the navigation system finishes rebuilding navigation data.
+     *  Re-plans the path if the rebuilt area overlapped it.
+     */
+    UFUNCTION()
+    void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+    /**
+     *  Schedules one automatic update, no sooner than UpdateInterval after the last one. No-op if one is already scheduled.
+     */
+    void ScheduleAutomaticUpdate();
+
+    /**
+     *  Runs a scheduled automatic update.
+     */
+    void HandleScheduledUpdate();
+
+    /**
+     *  Enables the component tick only while a time-sliced visual rebuild has segments left.
+     */
+    void RefreshTickEnabled();
+
+    /**
+     *  Computes the spline mesh parameters of a range of segments into SegmentBuffer.
+     *  Each spline point is sampled and ground-projected once, shared by the two segments that meet there.
+     *  @param FirstSegment First segment to compute
+     *  @param LastSegment Last segment to compute (inclusive)
+     */
+    void BuildSegmentBuffer(int32 FirstSegment, int32 LastSegment);
+
     /**
      *  Internal method to create or update a spline mesh at the given index.
      *  @param SegmentIndex The index of the spline mesh to update
      */
     void UpdateSplineMesh(int32 SegmentIndex);
+
+    /**
+     *  Re-plans the stretch between the player and a rejoin point a few segments ahead,
+     *  keeping the rest of the spline and its meshes untouched. The prefix query and its ground traces
+     *  run asynchronously when bUseAsyncPathfinding or bAsyncGroundProjection are set.
+     *  @return True if the path was spliced or the splice is in flight, false if a full rebuild is needed
+     */
+    bool SplicePathFromOwner();
+
+    /**
+     *  Subdivides and ground-projects the prefix from PendingSpliceStart to PendingSpliceRejoinPoint and splices it in.
+     *  Heights come from one async trace batch when bAsyncGroundProjection is set.
+     *  @param PrefixPath Navigation path of the prefix, or null for a straight prefix
+     *  @return True if the splice was made or is in flight
+     */
+    bool BuildSplicePrefix(UNavigationPath* PrefixPath);
+
+    /**
+     *  Completion callback of the async prefix query of a splice. Falls back to a full rebuild on failure.
+     */
+    void OnAsyncSpliceFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr NavPath);
+
+    /**
+     *  Completion callback of the ground projection batch of a splice prefix.
+     */
+    void OnSpliceGroundProjectionComplete(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask);
+
+    /**
+     *  Replaces the path up to PendingSpliceRejoinPoint with the given prefix points and updates only the affected visuals.
+     *  @param PrefixPath Navigation path of the prefix, or null for a straight prefix
+     *  @param GroundPoints Subdivided prefix points already projected to the ground, without the rejoin point
+     *  @return False if the splice could not be made and a full rebuild is needed
+     */
+    bool CommitSplice(UNavigationPath* PrefixPath, const TArray<FVector>& GroundPoints);
+
+    /**
+     *  Replaces the corners of CurrentPath before the rejoin point with the corners of a splice prefix,
+     *  so CurrentPath keeps describing the path that is shown.
+     */
+    void SpliceCurrentPath(const TArray<FVector>& PrefixCorners);
+
+    /**
+     *  Navmesh raycast along a straight splice prefix. When the way is clear the nav polygons it crosses
+     *  are collected in PendingSpliceCorridorPolys, since a straight prefix has no path corridor of its own.
+     *  @return True if the ray is blocked
+     */
+    bool RaycastSplicePrefix(const FVector& Start, const FVector& End);
+
+    /**
+     *  Owner location and rejoin point of the splice being built, and the corners of its prefix.
+     */
+    FVector PendingSpliceStart = FVector::ZeroVector;
+    FVector PendingSpliceRejoinPoint = FVector::ZeroVector;
+    TArray<FVector> PendingSpliceCorners;
+
+    /**
+     *  Nav polygons crossed by a straight splice prefix, added to CorridorPolys when the splice is committed.
+     */
+    TArray<NavNodeRef> PendingSpliceCorridorPolys;
+
+    /**
+     *  Finds the path segment nearest to a location, accelerated by CorridorGrid.
+     *  @param Location The world location to test
+     *  @param MaxDistance Segments further away than this are ignored
+     *  @param OutDistanceSquared Squared distance to the nearest segment
+     *  @return Index of the segment's start point in PathPoints, or INDEX_NONE
+     */
+    int32 FindNearestPathSegment(const FVector& Location, float MaxDistance, float& OutDistanceSquared) const;
+
+    /**
+     *  Drops the meshes of the first NumRemoved segments and opens NumAdded empty head slots,
+     *  so the remaining meshes keep drawing the same segments after the spline points shift.
+     */
+    void ShiftSplineMeshes(int32 NumRemoved, int32 NumAdded);
+
+    /**
+     *  Removes the segments the player has walked past without re-planning.
+     *  @param NumPassed Number of leading segments to remove
+     */
+    void TrimPassedSegments(int32 NumPassed);
+
+    /**
+     *  Rebuilds the XY grid of path segments used by FindNearestPathSegment.
+     */
+    void RebuildPathCorridor();
+
+    /**
+     *  Adds the nav polygons a navigation path runs through to CorridorPolys.
+     */
+    void AddCorridorPolys(UNavigationPath* NavPath);
+
+    /**
+     *  Whether the player is outside the corridor or has entered a nav polygon the path does not cross.
+     *  @param Location The player's feet location
+     *  @param NavPoly The nav polygon the player stands on
+     */
+    bool HasLeftPathCorridor(const FVector& Location, NavNodeRef NavPoly);
+
+    /**
+     *  Owner location at the bottom of its collision. Distances to the path are measured from here,
+     *  since the path lies on the ground and the actor location is the capsule centre.
+     */
+    FVector GetOwnerFeetLocation() const;
+
+    /**
+     *  Uniform XY grid mapping cells to the path segments overlapping them.
+     */
+    TMap<FIntPoint, TArray<int32>> CorridorGrid;
+
+    /**
+     *  Cell size of CorridorGrid in cm.
+     */
+    float CorridorCellSize = 150.0f;
+
+    /**
+     *  Nav polygons crossed by the current path.
+     */
+    TSet<NavNodeRef> CorridorPolys;
+
+    /**
+     *  Nav polygon the player stood on at the last corridor check.
+     */
+    NavNodeRef LastCorridorPoly = INVALID_NAVNODEREF;
+
+    /**
+     *  Nav polygon the owner was last located on and its neighbors, checked before any full navmesh projection.
+     */
+    NavNodeRef TrackedNavPoly = INVALID_NAVNODEREF;
+    TArray<NavNodeRef> TrackedNavPolyNeighbors;
+    TWeakObjectPtr<const ARecastNavMesh> TrackedNavMesh;
+
+    /**
+     *  Scratch buffer for polygon vertices used by the on-navmesh check.
+     */
+    mutable TArray<FVector> NavPolyVerts;
+
+    /**
+     *  Locates a point on the navmesh. The tracked polygon and its neighbors are tested first;
+     *  the full ProjectPointToNavigation query only runs when the point has left all of them.
+     *  @param NavSys The navigation system
+     *  @param Location The point to locate
+     *  @param OutNavLocation The point on the navmesh and the polygon it lies on
+     *  @return True if the point is on the navmesh
+     */
+    bool LocateOnNavmesh(UNavigationSystemV1& NavSys, const FVector& Location, FNavLocation& OutNavLocation);
+
+    /**
+     *  Whether a point lies over a nav polygon, within the vertical extent of the full projection.
+     *  @param OutPoint The point on the polygon below or above Location
+     */
+    bool IsOverNavPoly(const ARecastNavMesh& NavMesh, NavNodeRef PolyRef, const FVector& Location, float MaxVerticalDistance, FVector& OutPoint) const;
+
+    /**
+     *  Starts tracking a polygon and caches its neighbors.
+     */
+    void TrackNavPoly(const ARecastNavMesh& NavMesh, NavNodeRef PolyRef);
+
+    /**
+     *  Replaces the spline points with PathPoints in one bulk operation, using analytic tangents
+     *  so the spline is reparameterized once per build.
+     */
+    void RebuildSplineFromPathPoints();
+
+    /**
+     *  Rebuilds the ribbon mesh from the spline points. Used by EPathVisualType::Ribbon.
+     */
+    void UpdateRibbonMesh();
+
+    /**
+     *  Detail level a segment should be drawn at for the current LOD origin.
+     *  @param SegmentIndex The segment
+     *  @param OutSpanEnd Index of the last path point the segment's mesh reaches (further than SegmentIndex + 1 for Coarse)
+     */
+    ENavPathSegmentLOD ComputeSegmentLOD(int32 SegmentIndex, int32& OutSpanEnd) const;
+
+    /**
+     *  Builds, merges or hides a segment's mesh according to its LOD.
+     */
+    void UpdateSegmentVisual(int32 SegmentIndex);
+
+    /**
+     *  Draws a coarse mesh from one path point to another without ground traces or custom depth.
+     */
+    void UpdateCoarseSplineMesh(int32 SegmentIndex, int32 EndPointIndex);
+
+    /**
+     *  Measures LOD distances from the path point nearest the owner.
+     */
+    void SetLODOrigin(const FVector& OwnerLocation);
+
+    /**
+     *  Rebuilds only the segments whose LOD changed since the owner last moved along the path.
+     */
+    void RefreshPathLOD(const FVector& OwnerLocation);
+
+    /**
+     *  Queues every spline mesh segment for a time-sliced rebuild, starting at the segment nearest the owner
+     *  and working forward along the path before filling in the segments behind.
+     *  Queued meshes are hidden so no stale segment of the previous path shows before its slot is rebuilt.
+     */
+    void QueueVisualRebuild();
+
+    /**
+     *  Builds queued segments until the queue is empty or VisualRebuildBudgetMs is used up.
+     */
+    void ProcessVisualRebuildQueue();
+
+    /**  Whether a time-sliced rebuild still has segments to build. */
+    bool IsVisualRebuildPending() const { return VisualRebuildCursor < VisualRebuildQueue.Num(); }
+
+    /**  Drops the remaining segments of a time-sliced rebuild. */
+    void CancelVisualRebuild();
+
+    /**
+     *  Returns the pooled spline mesh for a spline segment, creating and registering one if needed.
+     *  @param SegmentIndex The spline segment the mesh draws
+     */
+    USplineMeshComponent* AcquireSplineMesh(int32 SegmentIndex);
+
+    /**
+     *  Hides pooled spline meshes that the current path does not use and trims the pool to MaxPooledSplineMeshes.
+     */
+    void ReleaseUnusedSplineMeshes();
+
+    /**
+     *  Destroys every pooled spline mesh. Used on EndPlay.
+     */
+    void DestroySplineMeshPool();
     
     /**
      *  Cached reference to the owning character for efficient access.
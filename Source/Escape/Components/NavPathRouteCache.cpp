@@ -0,0 +1,84 @@
+#include "NavPathRouteCache.h"
+
+/**
+ * Looks up a route and refreshes its recency
+ */
+const FNavPathRouteEntry* FNavPathRouteCache::Find(const FNavPathRouteKey& Key)
+{
+    if (FNavPathRouteEntry* Entry = Routes.Find(Key))
+    {
+        Entry->LastUsed = ++UseCounter;
+        ++Hits;
+        return Entry;
+    }
+    ++Misses;
+    return nullptr;
+}
+
+/**
+ * Stores a route, evicting the oldest one when full
+ */
+void FNavPathRouteCache::Store(const FNavPathRouteKey& Key, const TArray<FVector>& Points, const TArray<NavNodeRef>& CorridorPolys)
+{
+    if (Capacity <= 0 || !Key.IsValid() || Points.Num() < 2)
+    {
+        return;
+    }
+
+    FNavPathRouteEntry& Entry = Routes.FindOrAdd(Key);
+    Entry.Points = Points;
+    Entry.CorridorPolys = CorridorPolys;
+    Entry.Bounds = FBox(Points);
+    Entry.LastUsed = ++UseCounter;
+    EvictToCapacity();
+}
+
+/**
+ * Removes the routes overlapping a box
+ */
+void FNavPathRouteCache::InvalidateBox(const FBox& Bounds)
+{
+    if (!Bounds.IsValid)
+    {
+        return;
+    }
+    for (auto It = Routes.CreateIterator(); It; ++It)
+    {
+        if (It.Value().Bounds.Intersect(Bounds))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+/**
+ * Changes the capacity
+ */
+void FNavPathRouteCache::SetCapacity(int32 NewCapacity)
+{
+    Capacity = FMath::Max(NewCapacity, 0);
+    EvictToCapacity();
+}
+
+/**
+ * Evicts least recently used routes past the capacity
+ */
+void FNavPathRouteCache::EvictToCapacity()
+{
+    // The cache holds a handful of routes, so a linear scan for the oldest is cheaper than keeping an ordered list
+    while (Routes.Num() > Capacity)
+    {
+        const FNavPathRouteKey* OldestKey = nullptr;
+        uint64 OldestUse = MAX_uint64;
+        for (const TPair<FNavPathRouteKey, FNavPathRouteEntry>& Route : Routes)
+        {
+            if (Route.Value.LastUsed < OldestUse)
+            {
+                OldestUse = Route.Value.LastUsed;
+                OldestKey = &Route.Key;
+            }
+        }
+        const FNavPathRouteKey KeyToRemove = *OldestKey;
+        Routes.Remove(KeyToRemove);
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavigationTypes.h"
+
+/**
+ *  Identifies a cached route: the nav polygons at both ends and the query filter it was planned with.
+ */
+struct FNavPathRouteKey
+{
+    NavNodeRef StartPoly = INVALID_NAVNODEREF;
+    NavNodeRef EndPoly = INVALID_NAVNODEREF;
+    const UClass* FilterClass = nullptr;
+
+    bool IsValid() const { return StartPoly != INVALID_NAVNODEREF && EndPoly != INVALID_NAVNODEREF; }
+
+    bool operator==(const FNavPathRouteKey& Other) const
+    {
+        return StartPoly == Other.StartPoly && EndPoly == Other.EndPoly && FilterClass == Other.FilterClass;
+    }
+
+    friend uint32 GetTypeHash(const FNavPathRouteKey& Key)
+    {
+        return HashCombine(HashCombine(GetTypeHash(Key.StartPoly), GetTypeHash(Key.EndPoly)), GetTypeHash(Key.FilterClass));
+    }
+};
+
+/**
+ *  A route as it was committed to the guide: ground-projected spline points and the nav polygons the path crossed.
+ */
+struct FNavPathRouteEntry
+{
+    TArray<FVector> Points;
+    TArray<NavNodeRef> CorridorPolys;
+    FBox Bounds = FBox(ForceInit);
+    uint64 LastUsed = 0;
+};
+
+/**
+ *  FNavPathRouteCache
+ * Bounded least-recently-used cache of finished NavPathGuide routes.
+ * Entries are dropped by box when the navmesh under them is rebuilt; the oldest entry is evicted once the capacity is reached.
+ */
+class ESCAPE_API FNavPathRouteCache
+{
+public:
+    /**
+     *  Looks up a route and marks it as most recently used.
+     *  @param Key The route to look up
+     *  @return The cached route, or nullptr on a miss. Valid until the cache is next modified.
+     */
+    const FNavPathRouteEntry* Find(const FNavPathRouteKey& Key);
+
+    /**
+     *  Stores a route, evicting the least recently used one if the cache is full.
+     *  @param Key The route's key
+     *  @param Points Ground-projected spline points of the route
+     *  @param CorridorPolys Nav polygons the route crosses
+     */
+    void Store(const FNavPathRouteKey& Key, const TArray<FVector>& Points, const TArray<NavNodeRef>& CorridorPolys);
+
+    /**  Removes every route passing through the given box. */
+    void InvalidateBox(const FBox& Bounds);
+
+    /**  Removes every route. */
+    void Invalidate() { Routes.Reset(); }
+
+    /**  Sets the maximum number of routes kept, evicting the oldest ones past it. */
+    void SetCapacity(int32 NewCapacity);
+
+    /**  Resets hit/miss counters. */
+    void ResetStats() { Hits = 0; Misses = 0; }
+
+    int32 GetHits() const { return Hits; }
+    int32 GetMisses() const { return Misses; }
+    int32 Num() const { return Routes.Num(); }
+
+private:
+    /**  Removes least recently used routes until at most Capacity remain. */
+    void EvictToCapacity();
+
+    TMap<FNavPathRouteKey, FNavPathRouteEntry> Routes;
+    int32 Capacity = 16;
+    uint64 UseCounter = 0;
+    int32 Hits = 0;
+    int32 Misses = 0;
+};
@@ -0,0 +1,69 @@
+#include "NavPathSegmentBuffer.h"
+#include "Engine/StaticMesh.h"
+
+/**
+ * Sizes every array for the new path
+ */
+void FNavPathSegmentBuffer::Init(int32 NumSegments)
+{
+    StartPositions.SetNumUninitialized(NumSegments, EAllowShrinking::No);
+    EndPositions.SetNumUninitialized(NumSegments, EAllowShrinking::No);
+    StartTangents.SetNumUninitialized(NumSegments, EAllowShrinking::No);
+    EndTangents.SetNumUninitialized(NumSegments, EAllowShrinking::No);
+    Offsets.SetNumUninitialized(NumSegments, EAllowShrinking::No);
+    Scales.SetNumUninitialized(NumSegments, EAllowShrinking::No);
+    Built.Init(false, NumSegments);
+}
+
+/**
+ * Drops every segment
+ */
+void FNavPathSegmentBuffer::Reset()
+{
+    Init(0);
+}
+
+/**
+ * Removes the old head segments and makes room for the new ones
+ */
+void FNavPathSegmentBuffer::Shift(int32 NumRemoved, int32 NumAdded)
+{
+    NumRemoved = FMath::Clamp(NumRemoved, 0, Num());
+    const int32 NumTail = Num() - NumRemoved;
+
+    auto ShiftArray = [NumRemoved, NumAdded](auto& Array)
+    {
+        Array.RemoveAt(0, NumRemoved, EAllowShrinking::No);
+        Array.InsertUninitialized(0, NumAdded);
+    };
+    ShiftArray(StartPositions);
+    ShiftArray(EndPositions);
+    ShiftArray(StartTangents);
+    ShiftArray(EndTangents);
+    ShiftArray(Offsets);
+    ShiftArray(Scales);
+
+    TBitArray<> ShiftedBuilt(false, NumAdded);
+    for (int32 i = 0; i < NumTail; ++i)
+    {
+        ShiftedBuilt.Add(Built[NumRemoved + i]);
+    }
+    Built = MoveTemp(ShiftedBuilt);
+}
+
+/**
+ * Reads the mesh bounds once per mesh
+ */
+float FNavPathSegmentBuffer::GetMeshHalfWidth(const UStaticMesh* Mesh)
+{
+    if (!Mesh)
+    {
+        return 0.0f;
+    }
+    if (BoundsMesh.Get() != Mesh)
+    {
+        BoundsMesh = Mesh;
+        MeshHalfWidth = Mesh->GetBounds().BoxExtent.Y;
+    }
+    return MeshHalfWidth;
+}
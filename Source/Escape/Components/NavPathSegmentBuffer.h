@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/**
+ *  FNavPathSegmentBuffer
+ * Per-segment spline mesh parameters of the NavPathGuide path, kept as parallel arrays.
+ * Segments are computed in one pass over contiguous data and applied to the spline mesh components in a
+ * second pass. Entries can be built lazily; Built marks the segments whose parameters are current.
+ */
+class ESCAPE_API FNavPathSegmentBuffer
+{
+public:
+    /**  Sizes the buffer for a new path. Every segment starts out unbuilt. */
+    void Init(int32 NumSegments);
+
+    /**  Drops every segment. */
+    void Reset();
+
+    /**
+     *  Follows a change at the head of the path: the first NumRemoved segments are dropped and
+     *  NumAdded unbuilt segments are inserted in front of the remaining ones.
+     */
+    void Shift(int32 NumRemoved, int32 NumAdded);
+
+    int32 Num() const { return StartPositions.Num(); }
+    bool IsBuilt(int32 SegmentIndex) const { return Built.IsValidIndex(SegmentIndex) && Built[SegmentIndex]; }
+    void MarkBuilt(int32 SegmentIndex) { Built[SegmentIndex] = true; }
+
+    /**
+     *  Half the width of a mesh's bounds, read from the mesh only when the mesh changes.
+     *  @param Mesh The path mesh
+     *  @return The Y extent of the mesh bounds, or 0 without a mesh
+     */
+    float GetMeshHalfWidth(const UStaticMesh* Mesh);
+
+    /** Ground-projected endpoints, tangents, centring offset and scale of each segment. */
+    TArray<FVector> StartPositions;
+    TArray<FVector> EndPositions;
+    TArray<FVector> StartTangents;
+    TArray<FVector> EndTangents;
+    TArray<FVector> Offsets;
+    TArray<FVector2D> Scales;
+
+private:
+    TBitArray<> Built;
+
+    /** Mesh the cached half width was read from. */
+    TWeakObjectPtr<const UStaticMesh> BoundsMesh;
+    float MeshHalfWidth = 0.0f;
+};
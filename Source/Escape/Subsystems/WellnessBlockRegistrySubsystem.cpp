@@ -0,0 +1,226 @@
+#include "WellnessBlockRegistrySubsystem.h"
+
+/**
+ * Validates the configured cell size before any block registers
+ */
+void UWellnessBlockRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+    if (CellSize < 100.0f)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WellnessBlockRegistrySubsystem: CellSize is too small (%.2f), setting to 100.0."), CellSize);
+        CellSize = 100.0f;
+    }
+}
+
+/**
+ * Drops every registered block
+ */
+void UWellnessBlockRegistrySubsystem::Deinitialize()
+{
+    Grids.Reset();
+    Registrations.Reset();
+    Super::Deinitialize();
+}
+
+/**
+ * Files a block under its type and cell
+ */
+void UWellnessBlockRegistrySubsystem::RegisterBlock(AWellnessBlock* Block)
+{
+    if (!Block || Registrations.Contains(Block))
+    {
+        return;
+    }
+
+    const int32 TypeIndex = static_cast<int32>(Block->BlockType);
+    if (Grids.Num() <= TypeIndex)
+    {
+        Grids.SetNum(TypeIndex + 1);
+    }
+    FTypeGrid& Grid = Grids[TypeIndex];
+
+    const FVector Location = Block->GetActorLocation();
+    const FIntPoint Cell = ToCell(Location);
+    Grid.Cells.FindOrAdd(Cell).Add({ Block, Location });
+    Grid.MinCell = FIntPoint(FMath::Min(Grid.MinCell.X, Cell.X), FMath::Min(Grid.MinCell.Y, Cell.Y));
+    Grid.MaxCell = FIntPoint(FMath::Max(Grid.MaxCell.X, Cell.X), FMath::Max(Grid.MaxCell.Y, Cell.Y));
+    ++Grid.NumBlocks;
+
+    Registrations.Add(Block, { Block->BlockType, Cell });
+}
+
+/**
+ * Removes a block from the cell it was filed under
+ */
+void UWellnessBlockRegistrySubsystem::UnregisterBlock(AWellnessBlock* Block)
+{
+    FRegistration Registration;
+    if (!Block || !Registrations.RemoveAndCopyValue(Block, Registration))
+    {
+        return;
+    }
+
+    const int32 TypeIndex = static_cast<int32>(Registration.BlockType);
+    if (!Grids.IsValidIndex(TypeIndex))
+    {
+        return;
+    }
+    FTypeGrid& Grid = Grids[TypeIndex];
+    if (TArray<FEntry>* Entries = Grid.Cells.Find(Registration.Cell))
+    {
+        const int32 NumRemoved = Entries->RemoveAllSwap([Block](const FEntry& Entry) { return Entry.Block.Get() == Block; });
+        Grid.NumBlocks -= NumRemoved;
+        if (Entries->Num() == 0)
+        {
+            Grid.Cells.Remove(Registration.Cell);
+        }
+    }
+}
+
+/**
+ * Searches rings of cells outwards from the query point until no closer block can exist
+ */
+AWellnessBlock* UWellnessBlockRegistrySubsystem::FindNearestBlock(const FVector& Location, EWellnessBlockType BlockType, float MaxDistance) const
+{
+    const FTypeGrid* Grid = FindGrid(BlockType);
+    if (!Grid || Grid->NumBlocks == 0)
+    {
+        return nullptr;
+    }
+
+    const FIntPoint Center = ToCell(Location);
+    // Beyond this ring every cell lies outside the occupied area
+    const int32 MaxRing = FMath::Max(
+        FMath::Max(FMath::Abs(Center.X - Grid->MinCell.X), FMath::Abs(Grid->MaxCell.X - Center.X)),
+        FMath::Max(FMath::Abs(Center.Y - Grid->MinCell.Y), FMath::Abs(Grid->MaxCell.Y - Center.Y)));
+
+    AWellnessBlock* NearestBlock = nullptr;
+    float BestDistanceSquared = MaxDistance > 0.0f ? FMath::Square(MaxDistance) : TNumericLimits<float>::Max();
+    auto VisitCell = [&](const FIntPoint& Cell)
+    {
+        if (const TArray<FEntry>* Entries = Grid->Cells.Find(Cell))
+        {
+            for (const FEntry& Entry : *Entries)
+            {
+                const float DistanceSquared = FVector::DistSquared(Location, Entry.Location);
+                AWellnessBlock* Block = Entry.Block.Get();
+                if (Block && DistanceSquared < BestDistanceSquared)
+                {
+                    BestDistanceSquared = DistanceSquared;
+                    NearestBlock = Block;
+                }
+            }
+        }
+    };
+
+    // Rings closer than this lie entirely outside the occupied area, e.g. when querying from far away
+    const int32 MinRing = FMath::Max(
+        FMath::Max(0, FMath::Max(Grid->MinCell.X - Center.X, Center.X - Grid->MaxCell.X)),
+        FMath::Max(Grid->MinCell.Y - Center.Y, Center.Y - Grid->MaxCell.Y));
+
+    for (int32 Ring = MinRing; Ring <= MaxRing; ++Ring)
+    {
+        // Every point in ring N is at least (N - 1) cells away horizontally
+        if (Ring > 0 && FMath::Square((Ring - 1) * CellSize) >= BestDistanceSquared)
+        {
+            break;
+        }
+        if (Ring == 0)
+        {
+            VisitCell(Center);
+            continue;
+        }
+        // Only the part of the ring inside the occupied area can hold blocks
+        const int32 MinX = FMath::Max(Center.X - Ring, Grid->MinCell.X);
+        const int32 MaxX = FMath::Min(Center.X + Ring, Grid->MaxCell.X);
+        const int32 MinY = FMath::Max(Center.Y - Ring + 1, Grid->MinCell.Y);
+        const int32 MaxY = FMath::Min(Center.Y + Ring - 1, Grid->MaxCell.Y);
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            if (Center.Y - Ring >= Grid->MinCell.Y)
+            {
+                VisitCell(FIntPoint(X, Center.Y - Ring));
+            }
+            if (Center.Y + Ring <= Grid->MaxCell.Y)
+            {
+                VisitCell(FIntPoint(X, Center.Y + Ring));
+            }
+        }
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            if (Center.X - Ring >= Grid->MinCell.X)
+            {
+                VisitCell(FIntPoint(Center.X - Ring, Y));
+            }
+            if (Center.X + Ring <= Grid->MaxCell.X)
+            {
+                VisitCell(FIntPoint(Center.X + Ring, Y));
+            }
+        }
+    }
+    return NearestBlock;
+}
+
+/**
+ * Collects blocks from the cells overlapping the radius
+ */
+TArray<AWellnessBlock*> UWellnessBlockRegistrySubsystem::FindBlocksInRadius(const FVector& Location, float Radius, EWellnessBlockType BlockType) const
+{
+    TArray<AWellnessBlock*> Result;
+    const FTypeGrid* Grid = FindGrid(BlockType);
+    if (!Grid || Grid->NumBlocks == 0 || Radius <= 0.0f)
+    {
+        return Result;
+    }
+
+    const FIntPoint MinCell = ToCell(Location - FVector(Radius, Radius, 0.0f));
+    const FIntPoint MaxCell = ToCell(Location + FVector(Radius, Radius, 0.0f));
+    const float RadiusSquared = FMath::Square(Radius);
+    for (int32 X = FMath::Max(MinCell.X, Grid->MinCell.X); X <= FMath::Min(MaxCell.X, Grid->MaxCell.X); ++X)
+    {
+        for (int32 Y = FMath::Max(MinCell.Y, Grid->MinCell.Y); Y <= FMath::Min(MaxCell.Y, Grid->MaxCell.Y); ++Y)
+        {
+            const TArray<FEntry>* Entries = Grid->Cells.Find(FIntPoint(X, Y));
+            if (!Entries)
+            {
+                continue;
+            }
+            for (const FEntry& Entry : *Entries)
+            {
+                AWellnessBlock* Block = Entry.Block.Get();
+                if (Block && FVector::DistSquared(Location, Entry.Location) <= RadiusSquared)
+                {
+                    Result.Add(Block);
+                }
+            }
+        }
+    }
+    return Result;
+}
+
+/**
+ * Counts the blocks of a type
+ */
+int32 UWellnessBlockRegistrySubsystem::GetNumBlocks(EWellnessBlockType BlockType) const
+{
+    const FTypeGrid* Grid = FindGrid(BlockType);
+    return Grid ? Grid->NumBlocks : 0;
+}
+
+/**
+ * Converts a location into grid cell coordinates
+ */
+FIntPoint UWellnessBlockRegistrySubsystem::ToCell(const FVector& Location) const
+{
+    return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+/**
+ * Looks up the grid of a block type
+ */
+const UWellnessBlockRegistrySubsystem::FTypeGrid* UWellnessBlockRegistrySubsystem::FindGrid(EWellnessBlockType BlockType) const
+{
+    const int32 TypeIndex = static_cast<int32>(BlockType);
+    return Grids.IsValidIndex(TypeIndex) ? &Grids[TypeIndex] : nullptr;
+}
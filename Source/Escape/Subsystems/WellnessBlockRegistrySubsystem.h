@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "../WellnessBlock.h"
+#include "WellnessBlockRegistrySubsystem.generated.h"
+
+/**
+ *  UWellnessBlockRegistrySubsystem
+ * Spatial index of the wellness blocks in the world, kept as one uniform XY grid per block type.
+ * Blocks register themselves at BeginPlay and leave at EndPlay, so nearest-block and within-radius queries
+ * only visit the grid cells around the query point instead of iterating every actor in the level.
+ * Blocks are static; their location and type are captured when they register.
+ */
+UCLASS(Config = Game)
+class ESCAPE_API UWellnessBlockRegistrySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /**  Adds a block to the grid of its type. */
+    void RegisterBlock(AWellnessBlock* Block);
+
+    /**  Removes a block from the grid it was registered in. */
+    void UnregisterBlock(AWellnessBlock* Block);
+
+    /**
+     *  Finds the block of a type closest to a location.
+     *  @param Location The query location
+     *  @param BlockType The block type to look for
+     *  @param MaxDistance Blocks further away are ignored (0 = no limit)
+     *  @return The nearest block, or null if none is in range
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wellness|Registry")
+    AWellnessBlock* FindNearestBlock(const FVector& Location, EWellnessBlockType BlockType, float MaxDistance = 0.0f) const;
+
+    /**
+     *  Collects the blocks of a type within a radius of a location.
+     *  @param Location The query location
+     *  @param Radius Search radius in cm
+     *  @param BlockType The block type to look for
+     *  @return The blocks in range, in no particular order
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wellness|Registry")
+    TArray<AWellnessBlock*> FindBlocksInRadius(const FVector& Location, float Radius, EWellnessBlockType BlockType) const;
+
+    /**  Number of registered blocks of a type. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wellness|Registry")
+    int32 GetNumBlocks(EWellnessBlockType BlockType) const;
+
+    /**  Edge length of a grid cell in cm. Roughly the spacing of blocks in the level works best. Read from config; must stay fixed while blocks are registered. */
+    UPROPERTY(Config)
+    float CellSize = 2000.0f;
+
+private:
+    /** A registered block and where it was when it registered. */
+    struct FEntry
+    {
+        TWeakObjectPtr<AWellnessBlock> Block;
+        FVector Location = FVector::ZeroVector;
+    };
+
+    /** The grid of one block type. */
+    struct FTypeGrid
+    {
+        TMap<FIntPoint, TArray<FEntry>> Cells;
+        /** Cell range that has ever held a block; bounds the ring search. */
+        FIntPoint MinCell = FIntPoint(MAX_int32, MAX_int32);
+        FIntPoint MaxCell = FIntPoint(MIN_int32, MIN_int32);
+        int32 NumBlocks = 0;
+    };
+
+    /** Where each block was registered, so it can be removed from the right cell. */
+    struct FRegistration
+    {
+        EWellnessBlockType BlockType = EWellnessBlockType::None;
+        FIntPoint Cell = FIntPoint::ZeroValue;
+    };
+
+    /**  Grid cell containing a location. */
+    FIntPoint ToCell(const FVector& Location) const;
+
+    /**  The grid of a block type, or null for an unknown type. */
+    const FTypeGrid* FindGrid(EWellnessBlockType BlockType) const;
+
+    /** One grid per EWellnessBlockType value. */
+    TArray<FTypeGrid> Grids;
+    TMap<TWeakObjectPtr<AWellnessBlock>, FRegistration> Registrations;
+};
@@ -0,0 +1,215 @@
+#include "WellnessBlockTickSubsystem.h"
+#include "../WellnessBlock.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+/**
+ * Releases every block still registered
+ */
+void UWellnessBlockTickSubsystem::Deinitialize()
+{
+    for (AWellnessBlock* Block : ActiveBlocks)
+    {
+        if (Block)
+        {
+            Block->AnimationSlot = INDEX_NONE;
+        }
+    }
+    ActiveBlocks.Reset();
+    Significances.Reset();
+    PendingDeltaTimes.Reset();
+    Super::Deinitialize();
+}
+
+/**
+ * Steps every active block and drops the ones that came to rest
+ */
+void UWellnessBlockTickSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SignificanceTimer -= DeltaTime;
+    if (SignificanceTimer <= 0.0f)
+    {
+        UpdateSignificance();
+        SignificanceTimer = SignificanceUpdateInterval;
+    }
+
+    bIsTicking = true;
+    for (int32 Slot = 0; Slot < ActiveBlocks.Num(); ++Slot)
+    {
+        AWellnessBlock* Block = ActiveBlocks[Slot];
+        if (Block)
+        {
+            // Blocks outside the Full bucket bank their time and step less often, or not at all
+            PendingDeltaTimes[Slot] += DeltaTime;
+            const EWellnessBlockSignificance Significance = Significances[Slot];
+            if (Significance == EWellnessBlockSignificance::Off
+                || (Significance == EWellnessBlockSignificance::Reduced && PendingDeltaTimes[Slot] < ReducedStepInterval))
+            {
+                continue;
+            }
+            // Banked time is stepped through in bounded chunks so the state machine sees every phase it passes
+            bool bStillAnimating = true;
+            const float ChunkTime = FMath::Max(MaxCatchUpTime, 0.01f);
+            for (int32 Step = 0; bStillAnimating && Step < FMath::Max(MaxCatchUpSteps, 1) && PendingDeltaTimes[Slot] > 0.0f; ++Step)
+            {
+                const float StepTime = FMath::Min(PendingDeltaTimes[Slot], ChunkTime);
+                PendingDeltaTimes[Slot] -= StepTime;
+                bStillAnimating = Block->TickAnimation(StepTime);
+                // A step may have unregistered the block
+                if (ActiveBlocks[Slot] != Block)
+                {
+                    break;
+                }
+            }
+            if (bStillAnimating || ActiveBlocks[Slot] != Block)
+            {
+                continue;
+            }
+        }
+        if (Block)
+        {
+            Block->AnimationSlot = INDEX_NONE;
+        }
+        ActiveBlocks[Slot] = nullptr;
+    }
+    bIsTicking = false;
+
+    // Pack out the blocks that finished or unregistered during the update
+    for (int32 Slot = ActiveBlocks.Num() - 1; Slot >= 0; --Slot)
+    {
+        if (!ActiveBlocks[Slot])
+        {
+            RemoveSlot(Slot);
+        }
+    }
+}
+
+TStatId UWellnessBlockTickSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UWellnessBlockTickSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * Only ticks while IsTickable says there is work
+ */
+ETickableTickType UWellnessBlockTickSubsystem::GetTickableTickType() const
+{
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/**
+ * Appends a block to the packed array
+ */
+void UWellnessBlockTickSubsystem::RegisterBlock(AWellnessBlock* Block)
+{
+    if (!Block || (ActiveBlocks.IsValidIndex(Block->AnimationSlot) && ActiveBlocks[Block->AnimationSlot] == Block))
+    {
+        return;
+    }
+    Block->AnimationSlot = ActiveBlocks.Add(Block);
+    // New blocks start at full rate until the next re-score
+    Significances.Add(EWellnessBlockSignificance::Full);
+    PendingDeltaTimes.Add(0.0f);
+}
+
+/**
+ * Removes a block, deferring the packing while the update runs
+ */
+void UWellnessBlockTickSubsystem::UnregisterBlock(AWellnessBlock* Block)
+{
+    if (!Block || !ActiveBlocks.IsValidIndex(Block->AnimationSlot) || ActiveBlocks[Block->AnimationSlot] != Block)
+    {
+        return;
+    }
+    const int32 Slot = Block->AnimationSlot;
+    Block->AnimationSlot = INDEX_NONE;
+    if (bIsTicking)
+    {
+        ActiveBlocks[Slot] = nullptr;
+    }
+    else
+    {
+        RemoveSlot(Slot);
+    }
+}
+
+/**
+ * Swaps the last entry into the freed slot
+ */
+void UWellnessBlockTickSubsystem::RemoveSlot(int32 Slot)
+{
+    ActiveBlocks.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    Significances.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    PendingDeltaTimes.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+    if (ActiveBlocks.IsValidIndex(Slot) && ActiveBlocks[Slot])
+    {
+        ActiveBlocks[Slot]->AnimationSlot = Slot;
+    }
+}
+
+/**
+ * Looks up the bucket of a registered block
+ */
+EWellnessBlockSignificance UWellnessBlockTickSubsystem::GetBlockSignificance(const AWellnessBlock* Block) const
+{
+    if (!Block || !ActiveBlocks.IsValidIndex(Block->AnimationSlot) || ActiveBlocks[Block->AnimationSlot] != Block)
+    {
+        return EWellnessBlockSignificance::Off;
+    }
+    return Significances[Block->AnimationSlot];
+}
+
+/**
+ * Buckets every active block by gameplay relevance, camera distance and view direction
+ */
+void UWellnessBlockTickSubsystem::UpdateSignificance()
+{
+    APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+    if (!PC)
+    {
+        // Without a viewer there is nothing to cull against
+        for (EWellnessBlockSignificance& Significance : Significances)
+        {
+            Significance = EWellnessBlockSignificance::Full;
+        }
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    const FVector ViewDirection = ViewRotation.Vector();
+
+    for (int32 Slot = 0; Slot < ActiveBlocks.Num(); ++Slot)
+    {
+        const AWellnessBlock* Block = ActiveBlocks[Slot];
+        if (!Block)
+        {
+            continue;
+        }
+        // The block the player is using drives their activity state, so it always runs at full rate
+        if (Block->IsPlayerAtBlock())
+        {
+            Significances[Slot] = EWellnessBlockSignificance::Full;
+            continue;
+        }
+
+        const FVector ToBlock = Block->GetActorLocation() - ViewLocation;
+        const float Distance = ToBlock.Size();
+        const bool bInView = Distance <= KINDA_SMALL_NUMBER || FVector::DotProduct(ViewDirection, ToBlock / Distance) >= ViewConeCos;
+        if (Distance > OffDistance || (!bInView && Distance > NearDistance))
+        {
+            Significances[Slot] = EWellnessBlockSignificance::Off;
+        }
+        else if (bInView && Distance <= FullDetailDistance)
+        {
+            Significances[Slot] = EWellnessBlockSignificance::Full;
+        }
+        else
+        {
+            Significances[Slot] = EWellnessBlockSignificance::Reduced;
+        }
+    }
+}
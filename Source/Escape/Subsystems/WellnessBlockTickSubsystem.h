@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WellnessBlockTickSubsystem.generated.h"
+
+class AWellnessBlock;
+
+/**
+ *  How often an active block is animated, from how much it matters to the player right now.
+ */
+enum class EWellnessBlockSignificance : uint8
+{
+    Full,       // Every frame: the block in use, or close and in view
+    Reduced,    // At ReducedStepInterval: in view but far, or close behind the camera
+    Off         // Not stepped: out of view or beyond OffDistance. Elapsed time is caught up when it matters again
+};
+
+/**
+ *  UWellnessBlockTickSubsystem
+ * Steps the levitation of every animating wellness block in one batched update, so blocks don't need
+ * actor ticks of their own. Blocks register when their meditation state leaves None and drop out
+ * once it returns to None; the subsystem itself only ticks while at least one block is registered,
+ * so idle blocks cost nothing per frame.
+ * Active blocks are scored by distance to the camera, view direction and whether the player is at the block,
+ * and stepped every frame, at a reduced rate or not at all according to their significance bucket.
+ */
+UCLASS(Config = Game)
+class ESCAPE_API UWellnessBlockTickSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override { return ActiveBlocks.Num() > 0; }
+
+    /**  Adds a block to the batched update. Does nothing if it is already registered. */
+    void RegisterBlock(AWellnessBlock* Block);
+
+    /**  Removes a block from the batched update. Safe to call from inside the update. */
+    void UnregisterBlock(AWellnessBlock* Block);
+
+    /**  Number of blocks currently being animated. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wellness")
+    int32 GetNumActiveBlocks() const { return ActiveBlocks.Num(); }
+
+    /**  Significance bucket of an active block; idle blocks report Off. */
+    EWellnessBlockSignificance GetBlockSignificance(const AWellnessBlock* Block) const;
+
+    /**  Seconds between significance re-scores. */
+    UPROPERTY(Config)
+    float SignificanceUpdateInterval = 0.25f;
+
+    /**  Camera distance within which an in-view block is stepped every frame. */
+    UPROPERTY(Config)
+    float FullDetailDistance = 1500.0f;
+
+    /**  Camera distance beyond which a block is not stepped at all. */
+    UPROPERTY(Config)
+    float OffDistance = 6000.0f;
+
+    /**  Camera distance within which a block behind the camera is still stepped at the reduced rate. */
+    UPROPERTY(Config)
+    float NearDistance = 500.0f;
+
+    /**  Cosine of the half-angle of the view cone counted as in view. Wider than the camera FOV to cover turning. */
+    UPROPERTY(Config)
+    float ViewConeCos = 0.5f;
+
+    /**  Seconds between steps of a Reduced block. */
+    UPROPERTY(Config)
+    float ReducedStepInterval = 0.1f;
+
+    /**  Longest single time step handed to a block. Longer banked time is stepped through in chunks of this size. */
+    UPROPERTY(Config)
+    float MaxCatchUpTime = 0.5f;
+
+    /**  Most chunks a block is stepped per frame; time beyond that stays banked and is caught up over the next frames. */
+    UPROPERTY(Config)
+    int32 MaxCatchUpSteps = 8;
+
+private:
+    /**  Re-scores every active block against the first player's view. */
+    void UpdateSignificance();
+    /**  Removes the entry at the given slot by swapping the last entry into it. */
+    void RemoveSlot(int32 Slot);
+
+    /**
+     *  Blocks being animated, packed without gaps. Each block stores its slot, so unregistering is O(1).
+     *  Entries unregistered during the update are nulled and packed afterwards.
+     */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AWellnessBlock>> ActiveBlocks;
+
+    /**  Per-slot significance and time accumulated since the block was last stepped, parallel to ActiveBlocks. */
+    TArray<EWellnessBlockSignificance> Significances;
+    TArray<float> PendingDeltaTimes;
+
+    /**  Counts down to the next significance re-score. */
+    float SignificanceTimer = 0.0f;
+
+    /**  Set while the batched update runs. */
+    bool bIsTicking = false;
+};
@@ -0,0 +1,145 @@
+#include "WellnessProximitySubsystem.h"
+#include "WellnessBlockRegistrySubsystem.h"
+#include "../WellnessBlock.h"
+#include "../EscapeCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
+
+/**
+ * Stops the check timer
+ */
+void UWellnessProximitySubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(CheckTimerHandle);
+    }
+    ProximityBlocks.Reset();
+    CurrentBlock.Reset();
+    CurrentPlayer.Reset();
+    Super::Deinitialize();
+}
+
+/**
+ * Tracks a Proximity-mode block and starts checking with the first one
+ */
+void UWellnessProximitySubsystem::RegisterBlock(AWellnessBlock* Block)
+{
+    if (!Block || ProximityBlocks.Contains(Block))
+    {
+        return;
+    }
+    ProximityBlocks.Add(Block);
+    MaxEnterRadius = FMath::Max(MaxEnterRadius, Block->ProximityEnterRadius);
+
+    UWorld* World = GetWorld();
+    if (World && !World->GetTimerManager().IsTimerActive(CheckTimerHandle))
+    {
+        World->GetTimerManager().SetTimer(CheckTimerHandle, this, &UWellnessProximitySubsystem::CheckProximity, FMath::Max(CheckInterval, 0.01f), true);
+    }
+}
+
+/**
+ * Stops tracking a block and stops checking once none are left
+ */
+void UWellnessProximitySubsystem::UnregisterBlock(AWellnessBlock* Block)
+{
+    if (!Block || ProximityBlocks.RemoveSwap(Block) == 0)
+    {
+        return;
+    }
+    if (CurrentBlock.Get() == Block)
+    {
+        // The block is leaving play; the player can't stay in its range
+        Block->HandleCurrentPlayerExit();
+        CurrentBlock.Reset();
+        CurrentPlayer.Reset();
+    }
+    RefreshMaxEnterRadius();
+
+    if (ProximityBlocks.Num() == 0)
+    {
+        if (UWorld* World = GetWorld())
+        {
+            World->GetTimerManager().ClearTimer(CheckTimerHandle);
+        }
+    }
+}
+
+/**
+ * One distance query against the registry per interval
+ */
+void UWellnessProximitySubsystem::CheckProximity()
+{
+    UWorld* World = GetWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    AEscapeCharacter* Player = PC ? Cast<AEscapeCharacter>(PC->GetPawn()) : nullptr;
+    const UWellnessBlockRegistrySubsystem* Registry = World ? World->GetSubsystem<UWellnessBlockRegistrySubsystem>() : nullptr;
+    if (!Player || !Registry)
+    {
+        // Without a pawn the player can't be at any block
+        if (AWellnessBlock* Block = CurrentBlock.Get())
+        {
+            Block->HandleCurrentPlayerExit();
+        }
+        CurrentBlock.Reset();
+        CurrentPlayer.Reset();
+        return;
+    }
+    const FVector PlayerLocation = Player->GetActorLocation();
+
+    // Stay at the current block until the player is past its exit radius
+    if (AWellnessBlock* Block = CurrentBlock.Get())
+    {
+        if (CurrentPlayer.Get() == Player && FVector::DistSquared(PlayerLocation, Block->GetActorLocation()) <= FMath::Square(Block->ProximityExitRadius))
+        {
+            return;
+        }
+        // The character that entered may be gone or unpossessed by now, so exit whoever the block holds
+        Block->HandleCurrentPlayerExit();
+        CurrentBlock.Reset();
+        CurrentPlayer.Reset();
+    }
+
+    // Enter the nearest Proximity block whose own enter radius contains the player
+    AWellnessBlock* NearestBlock = nullptr;
+    float NearestDistanceSquared = TNumericLimits<float>::Max();
+    for (const EWellnessBlockType BlockType : TEnumRange<EWellnessBlockType>())
+    {
+        for (AWellnessBlock* Block : Registry->FindBlocksInRadius(PlayerLocation, MaxEnterRadius, BlockType))
+        {
+            if (Block->InteractionMode != EWellnessBlockInteractionMode::Proximity)
+            {
+                continue;
+            }
+            const float DistanceSquared = FVector::DistSquared(PlayerLocation, Block->GetActorLocation());
+            if (DistanceSquared <= FMath::Square(Block->ProximityEnterRadius) && DistanceSquared < NearestDistanceSquared)
+            {
+                NearestDistanceSquared = DistanceSquared;
+                NearestBlock = Block;
+            }
+        }
+    }
+    if (NearestBlock)
+    {
+        CurrentBlock = NearestBlock;
+        CurrentPlayer = Player;
+        NearestBlock->HandlePlayerEnter(Player);
+    }
+}
+
+/**
+ * Finds the largest enter radius among the tracked blocks
+ */
+void UWellnessProximitySubsystem::RefreshMaxEnterRadius()
+{
+    MaxEnterRadius = 0.0f;
+    for (const TWeakObjectPtr<AWellnessBlock>& Block : ProximityBlocks)
+    {
+        if (const AWellnessBlock* ValidBlock = Block.Get())
+        {
+            MaxEnterRadius = FMath::Max(MaxEnterRadius, ValidBlock->ProximityEnterRadius);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WellnessProximitySubsystem.generated.h"
+
+class AWellnessBlock;
+class AEscapeCharacter;
+
+/**
+ *  UWellnessProximitySubsystem
+ * Overlap-free interaction range detection for wellness blocks in Proximity mode.
+ * At a fixed low rate the player's location is checked against UWellnessBlockRegistrySubsystem: the player enters
+ * the nearest block within its ProximityEnterRadius and only leaves once further than its ProximityExitRadius.
+ * The gap between the two radii keeps a player jittering on the boundary from flickering in and out.
+ * The check timer only runs while at least one Proximity block is in play.
+ */
+UCLASS(Config = Game)
+class ESCAPE_API UWellnessProximitySubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /**  Adds a Proximity-mode block, starting the check timer with the first one. */
+    void RegisterBlock(AWellnessBlock* Block);
+
+    /**  Removes a Proximity-mode block, stopping the check timer with the last one. */
+    void UnregisterBlock(AWellnessBlock* Block);
+
+    /**  The block the player is currently in range of, or null. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Wellness|Interaction")
+    AWellnessBlock* GetCurrentBlock() const { return CurrentBlock.Get(); }
+
+    /**  Seconds between proximity checks. Changes apply from the next registration. */
+    UPROPERTY(Config)
+    float CheckInterval = 0.2f;
+
+private:
+    /**  Compares the player's location against the registry and fires enter/exit on the blocks. */
+    void CheckProximity();
+
+    /**  Recomputes the largest enter radius, which bounds the registry query. */
+    void RefreshMaxEnterRadius();
+
+    /** Proximity-mode blocks in play. */
+    TArray<TWeakObjectPtr<AWellnessBlock>> ProximityBlocks;
+
+    /** Block the player is in range of, and the player that entered it. */
+    TWeakObjectPtr<AWellnessBlock> CurrentBlock;
+    TWeakObjectPtr<AEscapeCharacter> CurrentPlayer;
+
+    float MaxEnterRadius = 0.0f;
+    FTimerHandle CheckTimerHandle;
+};
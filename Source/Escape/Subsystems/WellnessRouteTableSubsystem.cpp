@@ -0,0 +1,431 @@
+#include "WellnessRouteTableSubsystem.h"
+#include "../WellnessBlock.h"
+#include "../Components/NavPathGroundProjector.h"
+#include "EngineUtils.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
+#include "Kismet/GameplayStatics.h"
+#include "Algo/Reverse.h"
+
+/**
+ * The table is only needed where the game is played
+ */
+bool UWellnessRouteTableSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * Starts building the table, or waits for the navmesh if it is still being generated
+ */
+void UWellnessRouteTableSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    NavigationDirtiedHandle = UNavigationSystemV1::NavigationDirtyEvent.AddUObject(this, &UWellnessRouteTableSubsystem::OnNavigationDirtied);
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld);
+    if (!NavSys)
+    {
+        return;
+    }
+    NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UWellnessRouteTableSubsystem::OnNavigationGenerationFinished);
+
+    // Paths found on a half-built navmesh would be wrong; the generation finished event starts the build instead
+    if (!NavSys->IsNavigationBuildInProgress())
+    {
+        BuildRouteTable();
+    }
+}
+
+/**
+ * Drops the table and every request still in flight
+ */
+void UWellnessRouteTableSubsystem::Deinitialize()
+{
+    UNavigationSystemV1::NavigationDirtyEvent.Remove(NavigationDirtiedHandle);
+    if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+    {
+        NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UWellnessRouteTableSubsystem::OnNavigationGenerationFinished);
+    }
+    if (GroundProjector.IsValid())
+    {
+        GroundProjector->Cancel();
+    }
+    ProjectionQueue.Empty();
+    Nodes.Empty();
+    RoutePoints.Empty();
+
+    Super::Deinitialize();
+}
+
+/**
+ * Gathers the blocks and queues a path query for every pair
+ */
+void UWellnessRouteTableSubsystem::BuildRouteTable()
+{
+    UWorld* World = GetWorld();
+    if (!World || bTableStarted)
+    {
+        return;
+    }
+    bTableStarted = true;
+
+    for (TActorIterator<AWellnessBlock> It(World); It; ++It)
+    {
+        Nodes.Add(*It);
+        NodeLocations.Add(It->GetActorLocation());
+    }
+
+    const int32 NumNodes = Nodes.Num();
+    const int32 NumPairs = NumNodes * (NumNodes - 1) / 2;
+    PairNodes.Reserve(NumPairs);
+    for (int32 A = 0; A < NumNodes; ++A)
+    {
+        for (int32 B = A + 1; B < NumNodes; ++B)
+        {
+            PairNodes.Emplace(A, B);
+        }
+    }
+    RouteOffsets.Init(0, NumPairs);
+    RouteCounts.Init(INDEX_NONE, NumPairs);
+    RouteLengths.Init(-1.0f, NumPairs);
+    RouteBounds.Init(FBox(ForceInit), NumPairs);
+    RoutesInFlight.Init(false, NumPairs);
+    RoutesDirtiedInFlight.Init(false, NumPairs);
+
+    UE_LOG(LogTemp, Log, TEXT("WellnessRouteTable: Precomputing %d routes between %d wellness blocks."), NumPairs, NumNodes);
+    for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+    {
+        QueueRoute(PairIndex);
+    }
+}
+
+/**
+ * Submits the async path query of a block pair
+ */
+void UWellnessRouteTableSubsystem::QueueRoute(int32 PairIndex)
+{
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+    if (!NavData)
+    {
+        return;
+    }
+
+    const FIntPoint Pair = PairNodes[PairIndex];
+    FPathFindingQuery Query(this, *NavData, NodeLocations[Pair.X], NodeLocations[Pair.Y], UNavigationQueryFilter::GetQueryFilter(*NavData, this, nullptr));
+    // The query itself runs on the navigation system's async worker; the result comes back on the game thread
+    const uint32 QueryId = NavSys->FindPathAsync(
+        FNavAgentProperties::DefaultProperties,
+        Query,
+        FNavPathQueryDelegate::CreateUObject(this, &UWellnessRouteTableSubsystem::OnRoutePathFound, PairIndex),
+        EPathFindingMode::Regular
+    );
+    if (QueryId != INVALID_NAVQUERYID)
+    {
+        ++NumPendingRoutes;
+        RoutesInFlight[PairIndex] = true;
+        RouteBounds[PairIndex] = FBox(ForceInit);
+    }
+}
+
+/**
+ * Ends a pair's request, sending it round again if its area changed while it was in flight
+ */
+bool UWellnessRouteTableSubsystem::FinishRoute(int32 PairIndex)
+{
+    --NumPendingRoutes;
+    RoutesInFlight[PairIndex] = false;
+    if (!RoutesDirtiedInFlight[PairIndex])
+    {
+        return true;
+    }
+
+    // The result was computed against the navmesh as it was before the change
+    RoutesDirtiedInFlight[PairIndex] = false;
+    RequeueRoute(PairIndex);
+    return false;
+}
+
+/**
+ * Queries a pair again once the navmesh is settled
+ */
+void UWellnessRouteTableSubsystem::RequeueRoute(int32 PairIndex)
+{
+    const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    if (NavSys && NavSys->IsNavigationBuildInProgress())
+    {
+        StaleRoutes.Add(PairIndex);
+        return;
+    }
+    QueueRoute(PairIndex);
+}
+
+/**
+ * Subdivides a found path and queues it for ground projection
+ */
+void UWellnessRouteTableSubsystem::OnRoutePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr NavPath, int32 PairIndex)
+{
+    if (Result != ENavigationQueryResult::Success || !NavPath.IsValid() || NavPath->GetPathPoints().Num() < 2)
+    {
+        FinishRoute(PairIndex);
+        return;
+    }
+
+    // Same uniform subdivision the guide applies before projecting its own paths
+    const TArray<FNavPathPoint>& NavPoints = NavPath->GetPathPoints();
+    TArray<FVector> Points;
+    Points.Add(NavPoints[0].Location);
+    for (int32 i = 1; i < NavPoints.Num(); ++i)
+    {
+        const FVector Start = NavPoints[i - 1].Location;
+        const FVector End = NavPoints[i].Location;
+        const int32 NumSegments = FMath::Max(FMath::CeilToInt(FVector::Dist(Start, End) / PointSpacing), 1);
+        for (int32 s = 1; s <= NumSegments; ++s)
+        {
+            Points.Add(FMath::Lerp(Start, End, float(s) / float(NumSegments)));
+        }
+    }
+
+    // Lets navmesh changes during the projection be matched against the route
+    RouteBounds[PairIndex] = FBox(Points);
+    ProjectionQueue.Emplace(PairIndex, MoveTemp(Points));
+    ProjectNextRoute();
+}
+
+/**
+ * Feeds the ground projector one route at a time
+ */
+void UWellnessRouteTableSubsystem::ProjectNextRoute()
+{
+    if (ProjectionQueue.Num() == 0)
+    {
+        return;
+    }
+    if (!GroundProjector.IsValid())
+    {
+        GroundProjector = MakeShared<FNavPathGroundProjector>();
+    }
+    if (GroundProjector->IsBusy())
+    {
+        return;
+    }
+
+    // Heights are stored without an offset; each guide adds its own PathHeightOffset
+    FNavPathGroundTraceSettings TraceSettings;
+    TraceSettings.OffsetAboveGround = 0.0f;
+    if (APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(GetWorld(), 0))
+    {
+        TraceSettings.QueryParams.AddIgnoredActor(PlayerPawn);
+    }
+
+    TPair<int32, TArray<FVector>> Next = ProjectionQueue.Pop(EAllowShrinking::No);
+    if (!GroundProjector->Submit(GetWorld(), Next.Value, TraceSettings,
+        FOnGroundProjectionComplete::CreateUObject(this, &UWellnessRouteTableSubsystem::OnRouteProjected, Next.Key)))
+    {
+        FinishRoute(Next.Key);
+        ProjectNextRoute();
+    }
+}
+
+/**
+ * Appends a finished route to the flat table
+ */
+void UWellnessRouteTableSubsystem::OnRouteProjected(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask, int32 PairIndex)
+{
+    if (!FinishRoute(PairIndex))
+    {
+        ProjectNextRoute();
+        return;
+    }
+
+    RouteOffsets[PairIndex] = RoutePoints.Num();
+    RouteCounts[PairIndex] = ProjectedPoints.Num();
+    RoutePoints.Append(ProjectedPoints);
+    RouteBounds[PairIndex] = FBox(ProjectedPoints);
+    float Length = 0.0f;
+    for (int32 i = 1; i < ProjectedPoints.Num(); ++i)
+    {
+        Length += FVector::Dist(ProjectedPoints[i - 1], ProjectedPoints[i]);
+    }
+    RouteLengths[PairIndex] = Length;
+    CompactRoutePoints();
+
+    if (IsRouteTableReady())
+    {
+        UE_LOG(LogTemp, Log, TEXT("WellnessRouteTable: Route table ready (%d points)."), RoutePoints.Num());
+    }
+    ProjectNextRoute();
+}
+
+/**
+ * Marks finished routes through a dirtied area as stale, and routes in flight through it for another run
+ */
+void UWellnessRouteTableSubsystem::OnNavigationDirtied(const FBox& DirtyBounds)
+{
+    for (int32 PairIndex = 0; PairIndex < RouteCounts.Num(); ++PairIndex)
+    {
+        if (RoutesInFlight[PairIndex])
+        {
+            // A route whose path hasn't come back yet may run anywhere
+            if (!RouteBounds[PairIndex].IsValid || RouteBounds[PairIndex].Intersect(DirtyBounds))
+            {
+                RoutesDirtiedInFlight[PairIndex] = true;
+            }
+            continue;
+        }
+        if (RouteCounts[PairIndex] != INDEX_NONE && RouteBounds[PairIndex].Intersect(DirtyBounds))
+        {
+            RouteCounts[PairIndex] = INDEX_NONE;
+            StaleRoutes.Add(PairIndex);
+        }
+    }
+}
+
+/**
+ * Starts the table once the navmesh is ready and refreshes stale routes after later rebuilds
+ */
+void UWellnessRouteTableSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+    if (!bTableStarted)
+    {
+        BuildRouteTable();
+        return;
+    }
+    for (const int32 PairIndex : StaleRoutes)
+    {
+        QueueRoute(PairIndex);
+    }
+    StaleRoutes.Reset();
+}
+
+/**
+ * Rewrites RoutePoints without the points of replaced or invalidated routes once they make up half of it
+ */
+void UWellnessRouteTableSubsystem::CompactRoutePoints()
+{
+    int32 NumLivePoints = 0;
+    for (const int32 Count : RouteCounts)
+    {
+        NumLivePoints += FMath::Max(Count, 0);
+    }
+    if (RoutePoints.Num() <= NumLivePoints * 2)
+    {
+        return;
+    }
+
+    TArray<FVector> Compacted;
+    Compacted.Reserve(NumLivePoints);
+    for (int32 PairIndex = 0; PairIndex < RouteCounts.Num(); ++PairIndex)
+    {
+        if (RouteCounts[PairIndex] == INDEX_NONE)
+        {
+            continue;
+        }
+        const int32 NewOffset = Compacted.Num();
+        Compacted.Append(&RoutePoints[RouteOffsets[PairIndex]], RouteCounts[PairIndex]);
+        RouteOffsets[PairIndex] = NewOffset;
+    }
+    RoutePoints = MoveTemp(Compacted);
+}
+
+/**
+ * Index of an unordered pair in the triangular pair layout
+ */
+int32 UWellnessRouteTableSubsystem::GetPairIndex(int32 A, int32 B) const
+{
+    if (A > B)
+    {
+        Swap(A, B);
+    }
+    // Pairs are laid out row by row: (0,1) (0,2) ... (0,N-1) (1,2) ...
+    const int32 NumNodes = Nodes.Num();
+    return A * (2 * NumNodes - A - 1) / 2 + (B - A - 1);
+}
+
+/**
+ * Finds the block nearest a location
+ */
+int32 UWellnessRouteTableSubsystem::FindNearestNode(const FVector& Location, float MaxDistance) const
+{
+    int32 NearestNode = INDEX_NONE;
+    float NearestDistSq = FMath::Square(MaxDistance);
+    for (int32 i = 0; i < NodeLocations.Num(); ++i)
+    {
+        const float DistSq = FVector::DistSquared(Location, NodeLocations[i]);
+        if (DistSq <= NearestDistSq)
+        {
+            NearestDistSq = DistSq;
+            NearestNode = i;
+        }
+    }
+    return NearestNode;
+}
+
+/**
+ * Finds the table index of a block
+ */
+int32 UWellnessRouteTableSubsystem::FindNodeIndex(const AActor* Block) const
+{
+    return Block ? Nodes.IndexOfByPredicate([Block](const TWeakObjectPtr<AWellnessBlock>& Node) { return Node.Get() == Block; }) : INDEX_NONE;
+}
+
+/**
+ * Copies a finished route out of the table, oriented from the start block to the target
+ */
+bool UWellnessRouteTableSubsystem::FindRoute(const FVector& From, const AActor* Target, TArray<FVector>& OutPoints) const
+{
+    const int32 TargetNode = FindNodeIndex(Target);
+    const int32 StartNode = FindNearestNode(From, NodeSnapRadius);
+    if (TargetNode == INDEX_NONE || StartNode == INDEX_NONE || TargetNode == StartNode)
+    {
+        return false;
+    }
+
+    const int32 PairIndex = GetPairIndex(StartNode, TargetNode);
+    const int32 Count = RouteCounts[PairIndex];
+    if (Count == INDEX_NONE)
+    {
+        return false;
+    }
+
+    OutPoints.Reset(Count);
+    OutPoints.Append(&RoutePoints[RouteOffsets[PairIndex]], Count);
+    // Routes are stored from the lower to the higher block index
+    if (StartNode > TargetNode)
+    {
+        Algo::Reverse(OutPoints);
+    }
+    return true;
+}
+
+/**
+ * Length of the route between two blocks
+ */
+float UWellnessRouteTableSubsystem::GetRouteLength(const AActor* From, const AActor* To) const
+{
+    const int32 FromNode = FindNodeIndex(From);
+    const int32 ToNode = FindNodeIndex(To);
+    if (FromNode == INDEX_NONE || ToNode == INDEX_NONE || FromNode == ToNode)
+    {
+        return -1.0f;
+    }
+    const int32 PairIndex = GetPairIndex(FromNode, ToNode);
+    return RouteCounts[PairIndex] != INDEX_NONE ? RouteLengths[PairIndex] : -1.0f;
+}
+
+/**
+ * Length of the route from the block nearest a location to a target block
+ */
+float UWellnessRouteTableSubsystem::GetRouteLengthFrom(const FVector& From, const AActor* To) const
+{
+    const int32 FromNode = FindNearestNode(From, NodeSnapRadius);
+    const int32 ToNode = FindNodeIndex(To);
+    if (FromNode == INDEX_NONE || ToNode == INDEX_NONE || FromNode == ToNode)
+    {
+        return -1.0f;
+    }
+    const int32 PairIndex = GetPairIndex(FromNode, ToNode);
+    return RouteCounts[PairIndex] != INDEX_NONE ? RouteLengths[PairIndex] : -1.0f;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "WellnessRouteTableSubsystem.generated.h"
+
+class AWellnessBlock;
+class ANavigationData;
+class FNavPathGroundProjector;
+
+/**
+ *  UWellnessRouteTableSubsystem
+ * Precomputes navmesh routes between every pair of wellness blocks in the level at the start of play,
+ * so the navigation guide can draw a route between known blocks without running a path query.
+ * Meditation pads are wellness blocks of the Meditation type and are covered the same way.
+ * Paths are found with the navigation system's async queries, which run on a worker thread; the resulting
+ * polylines are then ground-projected with batched async traces. Finished routes are kept in flat arrays
+ * indexed by block pair, and routes through a rebuilt navmesh area are re-queried once the rebuild is done.
+ */
+UCLASS(Config = Game)
+class ESCAPE_API UWellnessRouteTableSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    /**
+     *  Looks up the precomputed route from the block nearest a location to a target block.
+     *  @param From The start location; must lie within NodeSnapRadius of a block
+     *  @param Target The destination block
+     *  @param OutPoints Ground points of the route (no height offset applied), starting at the block nearest From
+     *  @return True if a finished route was found
+     */
+    bool FindRoute(const FVector& From, const AActor* Target, TArray<FVector>& OutPoints) const;
+
+    /**
+     *  Length of the precomputed route between two blocks.
+     *  @return The route length in cm, or -1 if the route isn't available
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Route Table")
+    float GetRouteLength(const AActor* From, const AActor* To) const;
+
+    /**
+     *  Length of the precomputed route from the block nearest a location to a target block.
+     *  @param From The start location; must lie within NodeSnapRadius of a block
+     *  @return The route length in cm, or -1 if the route isn't available
+     */
+    float GetRouteLengthFrom(const FVector& From, const AActor* To) const;
+
+    /**  Whether every route of the table has been computed. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Route Table")
+    bool IsRouteTableReady() const { return bTableStarted && NumPendingRoutes == 0; }
+
+    /**  Number of blocks in the table. */
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation|Route Table")
+    int32 GetNumRouteNodes() const { return Nodes.Num(); }
+
+    /**  Index of a block in the table, or INDEX_NONE. */
+    int32 FindNodeIndex(const AActor* Block) const;
+
+    /**  Distance in cm within which a start location counts as standing at a block. */
+    UPROPERTY(Config)
+    float NodeSnapRadius = 400.0f;
+
+    /**  Spacing of route points in cm. Matches the guide's default MaxSplineSegmentLength. */
+    UPROPERTY(Config)
+    float PointSpacing = 75.0f;
+
+private:
+    /**  Gathers the blocks of the level and queues a path query for every pair. */
+    void BuildRouteTable();
+
+    /**  Submits the async path query of one block pair. */
+    void QueueRoute(int32 PairIndex);
+
+    /**  Receives a path query result and queues its polyline for ground projection. */
+    void OnRoutePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr NavPath, int32 PairIndex);
+
+    /**  Submits the next waiting polyline to the ground projector if it is idle. */
+    void ProjectNextRoute();
+
+    /**
+     *  Ends the query and projection of a pair. A pair whose area was dirtied while it was in flight is queried again.
+     *  @return True if the result is still valid and can be stored
+     */
+    bool FinishRoute(int32 PairIndex);
+
+    /**  Queries a pair again now, or once the navmesh rebuild in progress is done. */
+    void RequeueRoute(int32 PairIndex);
+
+    /**  Stores a ground-projected route in the flat table. */
+    void OnRouteProjected(const TArray<FVector>& ProjectedPoints, const TBitArray<>& HitMask, int32 PairIndex);
+
+    /**  Marks finished routes crossing a dirtied navmesh area as stale. */
+    void OnNavigationDirtied(const FBox& DirtyBounds);
+
+    /**  Builds the table once navigation is ready, or re-queries stale routes after a rebuild. */
+    UFUNCTION()
+    void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+    /**  Drops the points of replaced routes from RoutePoints. */
+    void CompactRoutePoints();
+
+    /**  Index of the unordered block pair (A, B) in the per-pair arrays. */
+    int32 GetPairIndex(int32 A, int32 B) const;
+
+    /**  Block nearest a location within MaxDistance, or INDEX_NONE. */
+    int32 FindNearestNode(const FVector& Location, float MaxDistance) const;
+
+    /** Blocks in the table and their locations at the time the table was built. */
+    TArray<TWeakObjectPtr<AWellnessBlock>> Nodes;
+    TArray<FVector> NodeLocations;
+
+    /** The two blocks of each pair, lower index first. */
+    TArray<FIntPoint> PairNodes;
+
+    /**
+     * Flat route table. The points of pair P are RoutePoints[RouteOffsets[P], RouteOffsets[P] + RouteCounts[P]),
+     * running from the lower to the higher block index. RouteCounts is INDEX_NONE while the route isn't available.
+     */
+    TArray<FVector> RoutePoints;
+    TArray<int32> RouteOffsets;
+    TArray<int32> RouteCounts;
+    TArray<float> RouteLengths;
+    TArray<FBox> RouteBounds;
+
+    /** Polylines waiting for the ground projector, and the pair it is working on. */
+    TArray<TPair<int32, TArray<FVector>>> ProjectionQueue;
+    TSharedPtr<FNavPathGroundProjector> GroundProjector;
+
+    /** Finished routes invalidated by navmesh changes, re-queried once the rebuild is done. */
+    TSet<int32> StaleRoutes;
+
+    /**
+     * Pairs whose path query or ground projection is in flight, and those of them whose area was dirtied meanwhile.
+     * RouteBounds of an in-flight pair hold its unprojected polyline once the path has been found.
+     */
+    TBitArray<> RoutesInFlight;
+    TBitArray<> RoutesDirtiedInFlight;
+
+    FDelegateHandle NavigationDirtiedHandle;
+    int32 NumPendingRoutes = 0;
+    bool bTableStarted = false;
+};
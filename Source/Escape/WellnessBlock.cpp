@@ -12,17 +12,20 @@
 #include "Widgets/MobileUIWidget.h" // Include mobile UI header for interaction prompts
 #include "Kismet/KismetMathLibrary.h" // For FInterpTo
 #include "Components/WellnessComponent.h" // Include wellness component header for interaction logic
+#include "Subsystems/WellnessBlockTickSubsystem.h" // Batched levitation updates for active blocks
+#include "Subsystems/WellnessBlockRegistrySubsystem.h" // Spatial index used for nearest-block queries
+#include "Subsystems/WellnessProximitySubsystem.h" // Overlap-free interaction range checks
 
 
 /**
  *  Constructor for the AWellnessBlock class.
  * Initializes components (Capsule Root, StaticMesh, Box Trigger), sets up attachments,
- * binds overlap events, enables ticking, and initializes default values for rotation and levitation state.
+ * binds overlap events, and initializes default values for rotation and levitation state.
  */
 AWellnessBlock::AWellnessBlock()
 {
-    // Enable the Tick function to be called every frame for updating rotation and levitation.
-    PrimaryActorTick.bCanEverTick = true;
+    // No actor tick: UWellnessBlockTickSubsystem steps the blocks that are actually levitating.
+    PrimaryActorTick.bCanEverTick = false;
 
     // Create the root component using a CapsuleComponent.
     SceneRootComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("SceneRootComponent"));
@@ -38,6 +41,16 @@ AWellnessBlock::AWellnessBlock()
     // Set collision profile for the mesh (example: BlockAllDynamic or a custom profile).
     BlockMesh->SetCollisionProfileName(UCollisionProfile::BlockAllDynamic_ProfileName);
 
+    // Create the visual-only mesh that levitates in place of BlockMesh when bVisualOnlyLevitation is set.
+    LevitationMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("LevitationMesh"));
+    // Attached to the root like BlockMesh, so both levitation modes move in the same root-relative space.
+    LevitationMesh->SetupAttachment(RootComponent);
+    // No collision and no overlap events, so moving it only updates its render transform and bounds.
+    LevitationMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    LevitationMesh->SetGenerateOverlapEvents(false);
+    LevitationMesh->SetCanEverAffectNavigation(false);
+    LevitationMesh->SetVisibility(false);
+
     // Create the box component used as a trigger volume for player interaction.
     TriggerVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("TriggerVolume"));
     TriggerVolume->SetupAttachment(BlockMesh); // Attach the trigger volume to the mesh component.
@@ -69,6 +82,18 @@ void AWellnessBlock::BeginPlay()
 {
     Super::BeginPlay(); // Call the parent class's BeginPlay.
 	InitialLocation = BlockMesh->GetRelativeLocation(); // Store the initial location of the block.
+    if (bVisualOnlyLevitation && BlockMesh && LevitationMesh)
+    {
+        // The visual copy takes over rendering; BlockMesh stays behind as the anchored collision.
+        LevitationMesh->SetStaticMesh(BlockMesh->GetStaticMesh());
+        for (int32 MaterialIndex = 0; MaterialIndex < BlockMesh->GetNumMaterials(); ++MaterialIndex)
+        {
+            LevitationMesh->SetMaterial(MaterialIndex, BlockMesh->GetMaterial(MaterialIndex));
+        }
+        LevitationMesh->SetRelativeTransform(BlockMesh->GetRelativeTransform());
+        LevitationMesh->SetVisibility(true);
+        BlockMesh->SetVisibility(false);
+    }
     // Sanitize speed values to ensure they are positive. Log warnings if adjustments are made.
     if (LowerSpeed <= 0.0f)
     {
@@ -90,26 +115,108 @@ void AWellnessBlock::BeginPlay()
         UE_LOG(LogTemp, Warning, TEXT("WellnessBlock '%s': RotationSpeed is negative (%.2f), setting to 0.0."), *GetName(), RotationSpeed);
         RotationSpeed = 0.0f;
     }
+
+    // A state set before BeginPlay (e.g. from a Blueprint default) still needs the batched update.
+    RefreshAnimationRegistration();
+
+    // Make the block findable by nearest-block and radius queries.
+    if (UWellnessBlockRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UWellnessBlockRegistrySubsystem>())
+    {
+        Registry->RegisterBlock(this);
+    }
+
+    // In proximity mode the trigger box is not used, so it should cost no broadphase work.
+    if (InteractionMode == EWellnessBlockInteractionMode::Proximity)
+    {
+        if (ProximityExitRadius < ProximityEnterRadius)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("WellnessBlock '%s': ProximityExitRadius (%.2f) is below ProximityEnterRadius, raising it to match."), *GetName(), ProximityExitRadius);
+            ProximityExitRadius = ProximityEnterRadius;
+        }
+        TriggerVolume->SetGenerateOverlapEvents(false);
+        TriggerVolume->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        if (UWellnessProximitySubsystem* Proximity = GetWorld()->GetSubsystem<UWellnessProximitySubsystem>())
+        {
+            Proximity->RegisterBlock(this);
+        }
+    }
 }
 
 /**
- *  Called every frame. Updates the block's rotation and levitation (if applicable) based on its state and player interaction.
- *  DeltaTime The time elapsed since the last frame.
+ *  Called when the actor is removed from play.
+ * Makes sure the tick, registry and proximity subsystems no longer reference this block.
  */
-void AWellnessBlock::Tick(float DeltaTime)
+void AWellnessBlock::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    Super::Tick(DeltaTime); // Call the parent class's Tick.
+    if (UWorld* World = GetWorld())
+    {
+        if (UWellnessBlockTickSubsystem* TickSubsystem = World->GetSubsystem<UWellnessBlockTickSubsystem>())
+        {
+            TickSubsystem->UnregisterBlock(this);
+        }
+        if (UWellnessBlockRegistrySubsystem* Registry = World->GetSubsystem<UWellnessBlockRegistrySubsystem>())
+        {
+            Registry->UnregisterBlock(this);
+        }
+        if (UWellnessProximitySubsystem* Proximity = World->GetSubsystem<UWellnessProximitySubsystem>())
+        {
+            Proximity->UnregisterBlock(this);
+        }
+    }
+    Super::EndPlay(EndPlayReason);
+}
 
-    
+/**
+ *  Sets the meditation state and adds or removes the block from the batched animation update accordingly.
+ *  NewMeditationBlockState The new levitation state.
+ */
+void AWellnessBlock::SetMeditationBlockState(EMeditationBlockState NewMeditationBlockState)
+{
+    MeditationBlockState = NewMeditationBlockState;
+    RefreshAnimationRegistration();
+}
 
+/**
+ *  Registers the block with the tick subsystem while it needs animating, and unregisters it otherwise.
+ */
+void AWellnessBlock::RefreshAnimationRegistration()
+{
+    UWorld* World = GetWorld();
+    // IsActorBeginningPlay covers the call from BeginPlay, before HasActorBegunPlay turns true.
+    if (!World || (!HasActorBegunPlay() && !IsActorBeginningPlay()))
+    {
+        return;
+    }
+    if (UWellnessBlockTickSubsystem* TickSubsystem = World->GetSubsystem<UWellnessBlockTickSubsystem>())
+    {
+        if (NeedsAnimation())
+        {
+            TickSubsystem->RegisterBlock(this);
+        }
+        else
+        {
+            TickSubsystem->UnregisterBlock(this);
+        }
+    }
+}
+
+/**
+ *  Called by UWellnessBlockTickSubsystem each frame while the block is registered. Updates the block's levitation based on its state and player interaction.
+ *  DeltaTime The time elapsed since the last frame.
+ *  Returns false once the block has come to rest, which drops it from the batched update.
+ */
+bool AWellnessBlock::TickAnimation(float DeltaTime)
+{
     // Update Levitation: Only perform levitation logic for Meditation blocks AND when the state is not 'None'.
-    if (BlockType == EWellnessBlockType::Meditation && MeditationBlockState != EMeditationBlockState::None)
+    if (NeedsAnimation())
     {
         // Levitation logic also implicitly depends on PlayerRef being valid within UpdateLevitation.
         UpdateLevitation(DeltaTime);
         // Update Rotation: Perform the rotation logic (oscillation or tilt response).
         //UpdateRotation(DeltaTime);
     }
+    // UpdateLevitation returns the state to None once the block has been lowered.
+    return NeedsAnimation();
 }
 
 
@@ -205,8 +312,19 @@ void AWellnessBlock::ApplyRotation()
  */
 void AWellnessBlock::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
-    // Check if the overlapping actor is a valid player character and not this block itself.
-    if (!CachedPlayerCharacter && OtherActor) CachedPlayerCharacter = Cast<AEscapeCharacter>(OtherActor);
+    HandlePlayerEnter(Cast<AEscapeCharacter>(OtherActor));
+}
+
+/**
+ *  Handles the player entering interaction range, from either the trigger overlap or the proximity check.
+ * Stores a reference to the player, updates the player's interacting block type,
+ * updates the mobile UI prompt, and hands this block to the player's meditation component.
+ *  Player The character that entered range. Ignored if null.
+ */
+void AWellnessBlock::HandlePlayerEnter(AEscapeCharacter* Player)
+{
+    // Check if the entering actor is a valid player character.
+    if (!CachedPlayerCharacter && Player) CachedPlayerCharacter = Player;
     if (CachedPlayerCharacter)
     {
         // Store a weak reference to the player character.
@@ -242,9 +360,19 @@ void AWellnessBlock::OnOverlapBegin(UPrimitiveComponent* OverlappedComp, AActor*
  *  OtherBodyIndex Body index for physics simulation.
  */
 void AWellnessBlock::OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+    HandlePlayerExit(Cast<AEscapeCharacter>(OtherActor));
+}
+
+/**
+ *  Handles the player leaving interaction range, from either the trigger overlap or the proximity check.
+ * Clears the player reference, resets the player's interacting block type and updates the mobile UI.
+ *  Player The character that left range.
+ */
+void AWellnessBlock::HandlePlayerExit(AEscapeCharacter* Player)
 {
     // Check if the actor leaving is the player character currently referenced by this block.
-    if (CachedPlayerCharacter && CachedPlayerCharacter == Cast<AEscapeCharacter>(OtherActor))
+    if (CachedPlayerCharacter && CachedPlayerCharacter == Player)
     {
         // Notify the character that they have left the block's trigger.
         CachedPlayerCharacter->bIsInBlock = false;
@@ -258,6 +386,15 @@ void AWellnessBlock::OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* O
     }
 }
 
+/**
+ *  Handles the character at this block leaving range without knowing which character that is,
+ * e.g. because the player's pawn is gone. Does nothing if no character is at the block.
+ */
+void AWellnessBlock::HandleCurrentPlayerExit()
+{
+    HandlePlayerExit(CachedPlayerCharacter);
+}
+
 /**
  *  Updates the vertical levitation position of the block based on the current MeditationBlockState.
  * Handles rising, floating up/down, and lowering states by adjusting the BlockMesh's relative Z location.
@@ -266,12 +403,11 @@ void AWellnessBlock::OnOverlapEnd(UPrimitiveComponent* OverlappedComp, AActor* O
  */
 void AWellnessBlock::UpdateLevitation(float DeltaTime)
 {
-    // Ensure the mesh component is valid before trying to move it.
-    if (!BlockMesh) return;
+    // Ensure the mesh components are valid before trying to move them.
+    if (!BlockMesh || !LevitationMesh) return;
 
-    // Get the current relative location of the mesh.
-    FVector CurrentLocation = BlockMesh->GetRelativeLocation();
-    float CurrentHeight = CurrentLocation.Z;
+    // Get the current height of whichever component levitates.
+    float CurrentHeight = GetLevitationHeight();
     float TargetHeight = CurrentHeight; // Initialize target height to current height
     float NewHeight = CurrentHeight; // Variable for calculating new height with constant speed
 
@@ -342,7 +478,36 @@ void AWellnessBlock::UpdateLevitation(float DeltaTime)
         return; // Exit early, no need to set location
     }
 
-    // Apply the new height to the mesh's relative location.
+    // Apply the new height to the levitating component.
+    SetLevitationHeight(NewHeight);
+}
+
+/**
+ *  Returns the current levitation height relative to the root component.
+ */
+float AWellnessBlock::GetLevitationHeight() const
+{
+    if (bVisualOnlyLevitation)
+    {
+        return LevitationMesh->GetRelativeLocation().Z;
+    }
+    return BlockMesh->GetRelativeLocation().Z;
+}
+
+/**
+ *  Moves the levitating component to the given height relative to the root component.
+ *  NewHeight The new height, in the same space as InitialLocation.
+ */
+void AWellnessBlock::SetLevitationHeight(float NewHeight)
+{
+    if (bVisualOnlyLevitation)
+    {
+        // Only the render transform and bounds of the collision-free copy change; the trigger and collision stay put.
+        const FVector CurrentOffset = LevitationMesh->GetRelativeLocation();
+        LevitationMesh->SetRelativeLocation(FVector(CurrentOffset.X, CurrentOffset.Y, NewHeight));
+        return;
+    }
+    const FVector CurrentLocation = BlockMesh->GetRelativeLocation();
     BlockMesh->SetRelativeLocation(FVector(CurrentLocation.X, CurrentLocation.Y, NewHeight));
 }
 
@@ -5,6 +5,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h"
 #include "InputActionValue.h" // Include if input actions are directly handled here (currently not)
+#include "Misc/EnumRange.h"
 #include "WellnessBlock.generated.h"
 
 // Forward declarations
@@ -29,6 +30,7 @@ enum class EWellnessBlockType : uint8
     /**  Represents an unassigned or default state. Interaction might default to Deep Breathing or do nothing. */
     None UMETA(DisplayName = "None")
 };
+ENUM_RANGE_BY_FIRST_AND_LAST(EWellnessBlockType, EWellnessBlockType::Stretching, EWellnessBlockType::None)
 
 /**
  *  Enum defining the different states of the meditation block's visual levitation effect.
@@ -49,6 +51,18 @@ enum class EMeditationBlockState : uint8
     Lowering UMETA(DisplayName = "Lowering")
 };
 
+/**
+ *  Enum defining how a WellnessBlock detects that the player is in interaction range.
+ */
+UENUM(BlueprintType)
+enum class EWellnessBlockInteractionMode : uint8
+{
+    /**  Physics overlaps with the TriggerVolume box. */
+    Overlap UMETA(DisplayName = "Overlap"),
+    /**  Periodic distance checks by UWellnessProximitySubsystem, with separate enter and exit radii. The TriggerVolume is disabled. */
+    Proximity UMETA(DisplayName = "Proximity")
+};
+
 /**
  *  AWellnessBlock
  * An interactive Actor placed in the game world that serves as an entry point for player wellness activities.
@@ -77,9 +91,9 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals|Rotation", meta = (ClampMin = "0.0", UIMin = "0.0"))
     float RotationSpeed = 100.0f;
 
-    /**  Sets the current state of the meditation block. This is used to determine the block's levitation and rotation behavior. */
+    /**  Sets the current state of the meditation block. This is used to determine the block's levitation and rotation behavior. Registers the block with UWellnessBlockTickSubsystem while it needs animating. */
     UFUNCTION(BlueprintCallable, Category = "Meditation")
-    void SetMeditationBlockState(EMeditationBlockState NewMeditationBlockState) { MeditationBlockState = NewMeditationBlockState; };
+    void SetMeditationBlockState(EMeditationBlockState NewMeditationBlockState);
 	/**  Gets the current state of the meditation block. This is used to determine the block's levitation and rotation behavior. */
     UFUNCTION(BlueprintCallable, Category = "Meditation")
     EMeditationBlockState GetMeditationBlockState() { return MeditationBlockState; };
@@ -126,6 +140,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals|Meditation", meta = (ClampMin = "0.0", UIMin = "0.0"))
     float RiseSpeed = 50.0f;
 
+    /**
+     *  If true, levitation moves LevitationMesh, a visual-only copy of the block mesh, instead of BlockMesh itself.
+     * BlockMesh's collision and the TriggerVolume then stay anchored at InitialLocation, so the per-frame move no longer
+     * re-evaluates overlaps or collision. Leave false if the player should physically ride the block up.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals|Meditation")
+    bool bVisualOnlyLevitation = false;
+
     // --- Configuration: Gameplay ---
 
     /**
@@ -135,6 +157,43 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wellness")
     EWellnessBlockType BlockType = EWellnessBlockType::None;
 
+    /**
+     *  How the block detects the player. Proximity mode skips the TriggerVolume's physics overlaps and is driven by
+     * UWellnessProximitySubsystem at a fixed low rate instead. Read at BeginPlay.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wellness|Interaction")
+    EWellnessBlockInteractionMode InteractionMode = EWellnessBlockInteractionMode::Overlap;
+
+    /**
+     *  In Proximity mode, the distance from the block at which the player enters interaction range.
+     * Units: Unreal Units.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wellness|Interaction", meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float ProximityEnterRadius = 200.0f;
+
+    /**
+     *  In Proximity mode, the distance from the block at which the player leaves interaction range.
+     * Kept larger than ProximityEnterRadius so a player standing on the edge doesn't flicker in and out.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wellness|Interaction", meta = (ClampMin = "0.0", UIMin = "0.0"))
+    float ProximityExitRadius = 260.0f;
+
+    /**
+     *  Marks the player as being at this block: sets bIsInBlock and the block type on the character, updates the
+     * interaction widget image and hands the block to the meditation component. Used by both interaction modes.
+     *  Player The character entering range.
+     */
+    void HandlePlayerEnter(AEscapeCharacter* Player);
+
+    /**
+     *  Undoes HandlePlayerEnter if the given character is the one at this block. Used by both interaction modes.
+     *  Player The character leaving range.
+     */
+    void HandlePlayerExit(AEscapeCharacter* Player);
+
+    /**  Undoes HandlePlayerEnter for whichever character is at this block, e.g. when that character is no longer possessed. */
+    void HandleCurrentPlayerExit();
+
     // --- Components ---
 
     /**
@@ -147,6 +206,13 @@ public:
     UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Components")
     TObjectPtr<UStaticMeshComponent> BlockMesh;
 
+    /**
+     *  Collision-free copy of BlockMesh that is animated instead of it when bVisualOnlyLevitation is set.
+     * Attached to the root and takes over BlockMesh's mesh, materials and relative transform at BeginPlay; hidden otherwise.
+     */
+    UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Components")
+    TObjectPtr<UStaticMeshComponent> LevitationMesh;
+
     /**  The Box Collision Component used as a trigger volume to detect when the player enters or leaves the interaction range. */
     UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "Components")
     TObjectPtr<UBoxComponent> TriggerVolume;
@@ -162,10 +228,17 @@ public:
     TWeakObjectPtr<ACharacter> PlayerRef;
 
     /**
-     *  Called every frame. Updates the block's rotation and levitation based on its state, player interaction, and time.
+     *  Advances the block's levitation by one step. Called by UWellnessBlockTickSubsystem for active blocks only; the block has no actor tick.
      *  DeltaTime Game time elapsed during the last frame.
+     *  Returns true while the block still needs updates.
      */
-    virtual void Tick(float DeltaTime) override;
+    bool TickAnimation(float DeltaTime);
+
+    /**  Whether a player is currently in this block's interaction range. */
+    bool IsPlayerAtBlock() const { return CachedPlayerCharacter != nullptr; }
+
+    /**  Whether the block is in a state that needs per-frame animation. */
+    bool NeedsAnimation() const { return BlockType == EWellnessBlockType::Meditation && MeditationBlockState != EMeditationBlockState::None; }
 
 protected:
     /**
@@ -174,6 +247,9 @@ protected:
      */
     virtual void BeginPlay() override;
 
+    /**  Called when the actor is removed from play. Drops the block from the batched animation update and the block registry. */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
     /**
      *  Callback function executed when an actor begins overlapping with the TriggerVolume.
      * Checks if the overlapping actor is the player, stores a reference, updates player state, and potentially triggers UI changes or block animations (like Rising).
@@ -211,8 +287,16 @@ private:
     /**  Internal variable storing the current state of the meditation levitation effect (None, Rising, FloatingUp, etc.). */
     EMeditationBlockState MeditationBlockState = EMeditationBlockState::None;
 
-    /**  Cached reference to the player as AEscapeCharacter for efficient cast reuse. */
-    AEscapeCharacter* CachedPlayerCharacter = nullptr;
+    /**  Slot of this block in UWellnessBlockTickSubsystem's active array, or INDEX_NONE while idle. Managed by the subsystem. */
+    int32 AnimationSlot = INDEX_NONE;
+    friend class UWellnessBlockTickSubsystem;
+
+    /**  Registers with or unregisters from UWellnessBlockTickSubsystem to match NeedsAnimation. */
+    void RefreshAnimationRegistration();
+
+    /**  Cached reference to the player as AEscapeCharacter for efficient cast reuse. Cleared by GC if the character is destroyed. */
+    UPROPERTY(Transient)
+    TObjectPtr<AEscapeCharacter> CachedPlayerCharacter = nullptr;
 
     // --- Internal Methods ---
     /**
@@ -229,4 +313,10 @@ private:
      *  DeltaTime Game time elapsed during the last frame.
      */
     void UpdateLevitation(float DeltaTime);
+
+    /**  Current levitation height in BlockMesh's relative space, read from whichever component levitates. */
+    float GetLevitationHeight() const;
+
+    /**  Moves whichever component levitates to the given height in BlockMesh's relative space. */
+    void SetLevitationHeight(float NewHeight);
 };